@@ -0,0 +1,82 @@
+// Times the UTFT pixel paths on the MKS TFT and prints the results on
+// Serial, once a second. Build once as is and once with UTFT_NO_RAMFUNC
+// defined (e.g. -DUTFT_NO_RAMFUNC in the build flags) to compare the loops
+// run from RAM with the same loops run from flash.
+
+#include "UTFT.h"
+
+UTFT myGLCD(UTFT_AUTO,LCD_RS,LCD_WR,LCD_CS,LCD_RD);
+extern uint8_t SmallFont[];
+extern uint8_t BigFont[];
+
+#if defined(STM32F107xC) && !defined(UTFT_NO_RAMFUNC)
+extern char _sramfunc[], _eramfunc[];	// from the linker script
+#endif
+
+#define RUNS 4
+#define BENCH_W 240	// portrait, the panels of the MKS TFT32 are all 240 wide
+#define BENCH_H 320
+
+static uint16_t line[BENCH_W];
+
+void report(const char *what, unsigned long us, long pixels)
+{
+  Serial.print(what);
+  Serial.print(": ");
+  Serial.print(us/RUNS);
+  Serial.print(" us, ");
+  Serial.print((pixels*RUNS*1000L)/(long)(us ? us : 1));
+  Serial.println(" kpixel/s");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(LCD_LED,OUTPUT);
+  digitalWrite(LCD_LED,HIGH);
+  myGLCD.Init(PORTRAIT);
+  for (int i=0; i<BENCH_W; i++)
+    line[i]=i*0x0841;
+
+  Serial.println();
+#if defined(STM32F107xC) && !defined(UTFT_NO_RAMFUNC)
+  Serial.print("RAM functions: ");
+  Serial.print((long)(_eramfunc-_sramfunc));
+  Serial.println(" bytes");
+#else
+  Serial.println("RAM functions: none, built with UTFT_NO_RAMFUNC");
+#endif
+  Serial.print("bus profile ");
+  Serial.println((long)myGLCD.getBusProfile());
+}
+
+void loop()
+{
+  unsigned long t;
+  int i, y;
+
+  // solid fills, _fast_fill_16()
+  t=micros();
+  for (i=0; i<RUNS; i++)
+    myGLCD.fillScr(i & 1 ? BLUE : RED);
+  report("fillScr", micros()-t, (long)BENCH_W*BENCH_H);
+
+  // pixel data from RAM, _burst_16()
+  t=micros();
+  for (i=0; i<RUNS; i++)
+    for (y=0; y<BENCH_H; y++)
+      myGLCD.drawBitmap(0, y, BENCH_W, 1, line);
+  report("drawBitmap", micros()-t, (long)BENCH_W*BENCH_H);
+
+  // opaque text, glyphs expanded by _burst_bits()
+  myGLCD.setColor(WHITE);
+  myGLCD.setBackColor(BLACK);
+  myGLCD.setFont(BigFont);
+  t=micros();
+  for (i=0; i<RUNS; i++)
+    for (y=0; y+16<=BENCH_H; y+=16)
+      myGLCD.printStr("0123456789ABCDE", 0, y);
+  report("printStr BigFont", micros()-t, (long)BENCH_W*BENCH_H);
+
+  delay(1000);
+}
@@ -1,10 +1,10 @@
 #include "UTFT.h"
-#include "memorysaver.h"
 #include <SPI.h>
 #include <SD.h>
 #include <XPT2046_Touchscreen.h>
 
 
+UTFT_DRIVERS(HX8353C);
 UTFT myGLCD(HX8353C,LCD_RS,LCD_WR,LCD_CS,LCD_RD,LANDSCAPE);
 extern uint8_t SmallFont[];
 extern uint8_t BigFont[];
@@ -84,13 +84,16 @@ void setup() {
   pinMode(TOUCH_DI,INPUT);
   pinMode(TOUCH_CS,OUTPUT);
   //pinMode(TOUCH_CS,HIGH);
-  //configure touch screen and LCD
+  //configure touch screen while the LCD controller wakes up
+  myGLCD.initAsync(PORTRAIT);
   ts.begin();
   ts.setRotation(4);
   //void XPT2046_Touchscreen::calibrate(float ax, float bx, int16_t dx, float ay, float by, int16_t dy, uint16_t dwidth, uint16_t dheight, uint8_t drot)
  // ts.calibrate(0.0881,0.00355,0,0.07246,0.354,0,320,240,3);
  //ts.calibrate(0,0,0,0,0,0,320,240);
-  myGLCD.Init(PORTRAIT);
+  while (!myGLCD.poll());
+  //one step slower than the fastest bus timing this panel reads back cleanly
+  myGLCD.tuneBus();
   myGLCD.setFont(SmallFont);
   myGLCD.setColor(LIME);
 
@@ -110,6 +113,13 @@ void setup() {
   myGLCD.printStr("test mkstft", 1, 1,0);
   myGLCD.printStr("FW V", 1, 20,0);
   myGLCD.printStr(FW_VERSION, 65, 20,0);
+  Serial.print("LCD ready in ");
+  Serial.print(myGLCD.getInitTime());
+  Serial.print(" ms, splash at ");
+  Serial.print(millis());
+  Serial.println(" ms");
+  Serial.print("bus profile ");
+  Serial.println((long)myGLCD.getBusProfile());
  
   delay(500);
 config_pwm();
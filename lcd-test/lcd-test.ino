@@ -2,12 +2,13 @@
 //    spfd5420
 
 #include "UTFT.h"
-#include "memorysaver.h"
 
 extern uint8_t SmallFont[];
 
 #define WITCH 400
 
+UTFT_DRIVERS(HX8353C);
+
 //UTFT lcdthingyname(byte model, int RS, int WR, int CS, int RST, int SER)
 UTFT myGLCD(HX8353C,LCD_RS,LCD_WR,LCD_CS,0);
 #define LED LED_BUILTIN
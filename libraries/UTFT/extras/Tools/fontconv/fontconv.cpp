@@ -0,0 +1,687 @@
+/*
+  fontconv.cpp - host side font compiler for UTFT
+
+  Converts BDF bitmap fonts (and TrueType/OpenType fonts when built with
+  FreeType) into the font layouts understood by UTFT::setFont():
+
+    legacy  - the fixed cell SmallFont/BigFont layout
+              (x_size, y_size, offset, numchars, then (x_size/8)*y_size
+              bytes per glyph, MSB first)
+    packed  - the proportional "packed" layout with a codepoint range
+              table, per glyph metrics and optionally RLE coded bitmaps
+
+  Build (Linux):
+    g++ -O2 -o fontconv fontconv.cpp
+    g++ -O2 -DUSE_FREETYPE `pkg-config --cflags freetype2` -o fontconv \
+        fontconv.cpp `pkg-config --libs freetype2`
+
+  Examples:
+    fontconv -r 32-126 -n SmallFont ter-u12n.bdf > SmallFont.c
+    fontconv -f packed -r 32-126,0xA0-0xFF,0x400-0x45F -n Sans16 \
+        -s 16 DejaVuSans.ttf > Sans16.c
+    fontconv -f packed -r 0x4E00-0x9FFF -s 16 --bin cjk16.bin font.ttf
+
+  Packed font layout (all multi-byte fields little endian):
+
+    0   0x00      marker, legacy fonts start with x_size which is never 0
+    1   'P'       magic
+    2   flags     bit0: glyph bitmaps are RLE coded
+    3   height    line height in pixels
+    4   ascent    baseline position, pixels from the top of the line
+    5   advance   widest glyph advance
+    6   nglyphs   u16
+    8   nranges   u16
+    10  fallback  u16, glyph drawn for codepoints the font does not map
+    12  bitmaps   u32, offset of the bitmap block from the start of the font
+    16  ranges    nranges * { u32 first codepoint, u16 count, u16 first glyph },
+                  in ascending codepoint order for a binary search
+        glyphs    nglyphs * { u24 bitmap offset, u8 width, u8 height,
+                              u8 advance, u8 xoff, u8 yoff }
+        bitmaps
+
+  Bitmaps are w*h pixels in row-major order. Uncompressed bitmaps are packed
+  MSB first and padded to a whole byte per glyph. RLE bitmaps are a stream of
+  nibbles (high nibble first) holding alternating background/foreground run
+  lengths, starting with background; a nibble of 15 means 15 pixels with no
+  colour change after it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#ifdef USE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+struct Glyph
+{
+	uint32_t	cp;
+	int			w, h;			// bitmap size
+	int			xoff, yoff;		// bitmap position inside the cell, yoff from the top of the line
+	int			advance;
+	std::vector<uint8_t> px;	// w*h, one byte per pixel (0/1)
+};
+
+struct Font
+{
+	int		height;
+	int		ascent;
+	std::map<uint32_t, Glyph> glyphs;
+};
+
+struct Range
+{
+	uint32_t	first, last;
+};
+
+static void die(const char *msg, const char *arg = "")
+{
+	fprintf(stderr, "fontconv: %s%s\n", msg, arg);
+	exit(1);
+}
+
+static bool in_ranges(const std::vector<Range> &ranges, uint32_t cp)
+{
+	if (ranges.empty())
+		return true;
+	for (size_t i = 0; i < ranges.size(); i++)
+		if (cp >= ranges[i].first && cp <= ranges[i].last)
+			return true;
+	return false;
+}
+
+static std::vector<Range> parse_ranges(const char *s)
+{
+	std::vector<Range> out;
+	while (*s)
+	{
+		char *end;
+		Range r;
+		r.first = strtoul(s, &end, 0);
+		if (end == s)
+			die("bad range list: ", s);
+		r.last = r.first;
+		s = end;
+		if (*s == '-')
+		{
+			s++;
+			r.last = strtoul(s, &end, 0);
+			if (end == s || r.last < r.first)
+				die("bad range list: ", s);
+			s = end;
+		}
+		out.push_back(r);
+		if (*s == ',')
+			s++;
+		else if (*s)
+			die("bad range list: ", s);
+	}
+	return out;
+}
+
+//*********************************
+// BDF input
+//*********************************
+
+static bool load_bdf(const char *path, const std::vector<Range> &ranges, Font &font)
+{
+	FILE *f = fopen(path, "r");
+	if (!f)
+		return false;
+
+	char line[512];
+	int fbb_w = 0, fbb_h = 0, fbb_x = 0, fbb_y = 0;
+	int ascent = -1, descent = -1;
+	bool in_char = false, in_bitmap = false;
+	long enc = -1;
+	int dwidth = 0, bw = 0, bh = 0, bx = 0, by = 0, row = 0;
+	std::vector<uint8_t> px;
+
+	while (fgets(line, sizeof(line), f))
+	{
+		if (in_bitmap)
+		{
+			if (!strncmp(line, "ENDCHAR", 7))
+			{
+				in_bitmap = in_char = false;
+				if (enc >= 0 && in_ranges(ranges, enc))
+				{
+					Glyph g;
+					g.cp = enc;
+					g.w = bw;
+					g.h = bh;
+					g.advance = dwidth;
+					g.xoff = bx;
+					g.yoff = ascent - (by + bh);
+					g.px = px;
+					font.glyphs[enc] = g;
+				}
+				continue;
+			}
+			if (row < bh)
+			{
+				for (int x = 0; x < bw; x++)
+				{
+					int nib = x / 4;
+					char c = line[nib];
+					int v = (c >= 'a') ? c - 'a' + 10 : (c >= 'A') ? c - 'A' + 10 : c - '0';
+					px[row * bw + x] = (v >> (3 - (x & 3))) & 1;
+				}
+				row++;
+			}
+			continue;
+		}
+		if (!strncmp(line, "FONTBOUNDINGBOX ", 16))
+			sscanf(line + 16, "%d %d %d %d", &fbb_w, &fbb_h, &fbb_x, &fbb_y);
+		else if (!strncmp(line, "FONT_ASCENT ", 12))
+			ascent = atoi(line + 12);
+		else if (!strncmp(line, "FONT_DESCENT ", 13))
+			descent = atoi(line + 13);
+		else if (!strncmp(line, "STARTCHAR", 9))
+		{
+			in_char = true;
+			enc = -1;
+			dwidth = fbb_w;
+			bw = fbb_w; bh = fbb_h; bx = fbb_x; by = fbb_y;
+		}
+		else if (in_char && !strncmp(line, "ENCODING ", 9))
+			enc = atol(line + 9);
+		else if (in_char && !strncmp(line, "DWIDTH ", 7))
+			dwidth = atoi(line + 7);
+		else if (in_char && !strncmp(line, "BBX ", 4))
+			sscanf(line + 4, "%d %d %d %d", &bw, &bh, &bx, &by);
+		else if (in_char && !strncmp(line, "BITMAP", 6))
+		{
+			if (ascent < 0)
+			{
+				ascent = fbb_h + fbb_y;
+				descent = -fbb_y;
+			}
+			in_bitmap = true;
+			row = 0;
+			px.assign(bw * bh, 0);
+		}
+	}
+	fclose(f);
+
+	if (ascent < 0 || descent < 0)
+		die("BDF without FONTBOUNDINGBOX/FONT_ASCENT: ", path);
+	font.ascent = ascent;
+	font.height = ascent + descent;
+	return true;
+}
+
+//*********************************
+// TrueType input
+//*********************************
+
+#ifdef USE_FREETYPE
+static bool load_ttf(const char *path, int size, const std::vector<Range> &ranges, Font &font)
+{
+	FT_Library lib;
+	FT_Face face;
+
+	if (FT_Init_FreeType(&lib))
+		die("cannot initialise FreeType");
+	if (FT_New_Face(lib, path, 0, &face))
+		return false;
+	FT_Set_Pixel_Sizes(face, 0, size);
+
+	font.ascent = (face->size->metrics.ascender + 63) >> 6;
+	font.height = font.ascent + ((-face->size->metrics.descender + 63) >> 6);
+
+	std::vector<Range> want = ranges;
+	if (want.empty())
+	{
+		Range r = { 32, 126 };
+		want.push_back(r);
+	}
+	for (size_t i = 0; i < want.size(); i++)
+		for (uint32_t cp = want[i].first; cp <= want[i].last; cp++)
+		{
+			FT_UInt gi = FT_Get_Char_Index(face, cp);
+			if (gi == 0 && cp != 32)
+				continue;
+			if (FT_Load_Glyph(face, gi, FT_LOAD_RENDER | FT_LOAD_TARGET_MONO))
+				continue;
+			FT_GlyphSlot s = face->glyph;
+			Glyph g;
+			g.cp = cp;
+			g.w = s->bitmap.width;
+			g.h = s->bitmap.rows;
+			g.xoff = s->bitmap_left;
+			g.yoff = font.ascent - s->bitmap_top;
+			g.advance = (s->advance.x + 32) >> 6;
+			g.px.assign(g.w * g.h, 0);
+			for (int y = 0; y < g.h; y++)
+				for (int x = 0; x < g.w; x++)
+				{
+					const uint8_t *r = s->bitmap.buffer + y * s->bitmap.pitch;
+					g.px[y * g.w + x] = (r[x >> 3] >> (7 - (x & 7))) & 1;
+				}
+			font.glyphs[cp] = g;
+		}
+	FT_Done_Face(face);
+	FT_Done_FreeType(lib);
+	return true;
+}
+#endif
+
+//*********************************
+// Glyph normalisation
+//*********************************
+
+// Crop empty borders and clip the bitmap into the [0,advance) x [0,height)
+// cell, so the renderer never has to draw outside the cell it clears.
+static void normalise(Font &font)
+{
+	for (std::map<uint32_t, Glyph>::iterator it = font.glyphs.begin(); it != font.glyphs.end(); ++it)
+	{
+		Glyph &g = it->second;
+		int x0 = g.w, y0 = g.h, x1 = -1, y1 = -1;
+
+		for (int y = 0; y < g.h; y++)
+			for (int x = 0; x < g.w; x++)
+				if (g.px[y * g.w + x])
+				{
+					x0 = std::min(x0, x); x1 = std::max(x1, x);
+					y0 = std::min(y0, y); y1 = std::max(y1, y);
+				}
+		if (x1 < 0)
+		{
+			g.w = g.h = g.xoff = g.yoff = 0;
+			g.px.clear();
+		}
+		else
+		{
+			// clip to the cell
+			int cx0 = std::max(x0, -g.xoff), cy0 = std::max(y0, -g.yoff);
+			int cy1 = std::min(y1, font.height - 1 - g.yoff);
+			if (g.advance < 1)
+				g.advance = 1;
+			if (g.xoff + x1 >= 255)
+				x1 = 254 - g.xoff;
+			std::vector<uint8_t> n;
+			int nw = x1 - cx0 + 1, nh = cy1 - cy0 + 1;
+			if (nw <= 0 || nh <= 0)
+				nw = nh = 0;
+			n.assign(nw * nh, 0);
+			for (int y = 0; y < nh; y++)
+				for (int x = 0; x < nw; x++)
+					n[y * nw + x] = g.px[(y + cy0) * g.w + x + cx0];
+			g.xoff += cx0;
+			g.yoff += cy0;
+			g.w = nw;
+			g.h = nh;
+			g.px = n;
+		}
+		if (g.advance < g.xoff + g.w)
+			g.advance = g.xoff + g.w;
+		if (g.advance > 255)
+			g.advance = 255;
+	}
+}
+
+//*********************************
+// Encoders
+//*********************************
+
+static std::vector<uint8_t> pack_bits(const Glyph &g)
+{
+	std::vector<uint8_t> out((g.w * g.h + 7) / 8, 0);
+	for (int i = 0; i < g.w * g.h; i++)
+		if (g.px[i])
+			out[i >> 3] |= 0x80 >> (i & 7);
+	return out;
+}
+
+static std::vector<uint8_t> pack_rle(const Glyph &g)
+{
+	std::vector<uint8_t> nib;
+	int n = g.w * g.h, i = 0;
+	uint8_t colour = 0;
+
+	while (i < n)
+	{
+		int run = 0;
+		while (i < n && g.px[i] == colour)
+		{
+			run++;
+			i++;
+		}
+		while (run >= 15)
+		{
+			nib.push_back(15);
+			run -= 15;
+		}
+		nib.push_back(run);
+		colour ^= 1;
+	}
+	std::vector<uint8_t> out((nib.size() + 1) / 2, 0);
+	for (size_t k = 0; k < nib.size(); k++)
+		out[k >> 1] |= (k & 1) ? nib[k] : nib[k] << 4;
+	return out;
+}
+
+static void put16(std::vector<uint8_t> &v, uint32_t x)
+{
+	v.push_back(x & 0xFF);
+	v.push_back((x >> 8) & 0xFF);
+}
+
+static void put32(std::vector<uint8_t> &v, uint32_t x)
+{
+	put16(v, x & 0xFFFF);
+	put16(v, x >> 16);
+}
+
+struct Stats
+{
+	size_t	total;
+	size_t	raw_bitmaps;
+	size_t	rle_bitmaps;
+	size_t	legacy_equiv;
+};
+
+static std::vector<uint8_t> build_packed(const Font &font, uint32_t fallback_cp, bool allow_rle, Stats &st)
+{
+	std::vector<const Glyph*> order;
+	for (std::map<uint32_t, Glyph>::const_iterator it = font.glyphs.begin(); it != font.glyphs.end(); ++it)
+		order.push_back(&it->second);
+
+	// build both encodings and keep the smaller one
+	std::vector<uint8_t> raw, rle;
+	std::vector<uint32_t> raw_off, rle_off;
+	int maxadv = 0, maxw = 0;
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		std::vector<uint8_t> a = pack_bits(*order[i]), b = pack_rle(*order[i]);
+		raw_off.push_back(raw.size());
+		rle_off.push_back(rle.size());
+		raw.insert(raw.end(), a.begin(), a.end());
+		rle.insert(rle.end(), b.begin(), b.end());
+		maxadv = std::max(maxadv, order[i]->advance);
+		maxw = std::max(maxw, order[i]->xoff + order[i]->w);
+	}
+	bool use_rle = allow_rle && rle.size() < raw.size();
+	const std::vector<uint8_t> &bm = use_rle ? rle : raw;
+	const std::vector<uint32_t> &off = use_rle ? rle_off : raw_off;
+	if (bm.size() > 0xFFFFFF)
+		die("bitmap block exceeds 16 MB");
+
+	// contiguous codepoint ranges
+	std::vector<uint8_t> rtab;
+	int nranges = 0;
+	for (size_t i = 0; i < order.size(); )
+	{
+		size_t j = i + 1;
+		while (j < order.size() && order[j]->cp == order[j - 1]->cp + 1 && j - i < 0xFFFF)
+			j++;
+		put32(rtab, order[i]->cp);
+		put16(rtab, j - i);
+		put16(rtab, i);
+		nranges++;
+		i = j;
+	}
+
+	// the requested fallback, else U+FFFD, else '?'
+	int fallback = -1, qmark = 0;
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		if (order[i]->cp == (fallback_cp ? fallback_cp : 0xFFFD))
+			fallback = i;
+		if (order[i]->cp == '?')
+			qmark = i;
+	}
+	if (fallback < 0)
+		fallback = qmark;
+
+	std::vector<uint8_t> out;
+	out.push_back(0x00);
+	out.push_back('P');
+	out.push_back(use_rle ? 1 : 0);
+	out.push_back(font.height);
+	out.push_back(font.ascent);
+	out.push_back(maxadv);
+	put16(out, order.size());
+	put16(out, nranges);
+	put16(out, fallback);
+	put32(out, 16 + rtab.size() + 8 * order.size());
+	out.insert(out.end(), rtab.begin(), rtab.end());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const Glyph &g = *order[i];
+		out.push_back(off[i] & 0xFF);
+		out.push_back((off[i] >> 8) & 0xFF);
+		out.push_back((off[i] >> 16) & 0xFF);
+		out.push_back(g.w);
+		out.push_back(g.h);
+		out.push_back(g.advance);
+		out.push_back(g.xoff);
+		out.push_back(g.yoff);
+	}
+	out.insert(out.end(), bm.begin(), bm.end());
+
+	st.total = out.size();
+	st.raw_bitmaps = raw.size();
+	st.rle_bitmaps = rle.size();
+	st.legacy_equiv = 4 + order.size() * ((std::max(maxadv, maxw) + 7) / 8) * font.height;
+	return out;
+}
+
+static std::vector<uint8_t> build_legacy(const Font &font, Stats &st)
+{
+	if (font.glyphs.empty())
+		die("no glyphs selected");
+	uint32_t first = font.glyphs.begin()->first, last = font.glyphs.rbegin()->first;
+	if (last > 255)
+		die("legacy fonts only cover codepoints 0-255, use -f packed");
+
+	int cell = 0;
+	for (std::map<uint32_t, Glyph>::const_iterator it = font.glyphs.begin(); it != font.glyphs.end(); ++it)
+		cell = std::max(cell, std::max(it->second.advance, it->second.xoff + it->second.w));
+	int x_size = (cell + 7) & ~7, y_size = font.height, bpr = x_size / 8;
+	if (x_size > 255 || y_size > 255)
+		die("glyphs too large for the legacy layout");
+
+	std::vector<uint8_t> out;
+	out.push_back(x_size);
+	out.push_back(y_size);
+	out.push_back(first);
+	out.push_back(last - first + 1);
+	for (uint32_t cp = first; cp <= last; cp++)
+	{
+		std::vector<uint8_t> cellbits(bpr * y_size, 0);
+		std::map<uint32_t, Glyph>::const_iterator it = font.glyphs.find(cp);
+		if (it != font.glyphs.end())
+		{
+			const Glyph &g = it->second;
+			for (int y = 0; y < g.h; y++)
+				for (int x = 0; x < g.w; x++)
+					if (g.px[y * g.w + x])
+					{
+						int cx = x + g.xoff, cy = y + g.yoff;
+						cellbits[cy * bpr + (cx >> 3)] |= 0x80 >> (cx & 7);
+					}
+		}
+		out.insert(out.end(), cellbits.begin(), cellbits.end());
+	}
+	st.total = st.legacy_equiv = out.size();
+	st.raw_bitmaps = st.rle_bitmaps = out.size() - 4;
+	return out;
+}
+
+//*********************************
+// Output
+//*********************************
+
+static void glyph_comment(FILE *o, uint32_t cp)
+{
+	if (cp == ' ')
+		fprintf(o, " // <Space>");
+	else if (cp > ' ' && cp < 127)
+		fprintf(o, " // %c", (int)cp);
+	else
+		fprintf(o, " // U+%04X", (unsigned)cp);
+}
+
+static void write_c(FILE *o, const char *name, const std::vector<uint8_t> &data, const Font &font, bool legacy)
+{
+	fprintf(o, "#if defined(__AVR__)\n"
+	           "\t#include <avr/pgmspace.h>\n"
+	           "\t#define fontdatatype const uint8_t\n"
+	           "#elif defined(__PIC32MX__)\n"
+	           "\t#define PROGMEM\n"
+	           "\t#define fontdatatype const unsigned char\n"
+	           "#elif defined(__arm__)\n"
+	           "\t#define PROGMEM\n"
+	           "\t#define fontdatatype const unsigned char\n"
+	           "#endif\n\n");
+	fprintf(o, "// %s.c\n", name);
+	if (legacy)
+		fprintf(o, "// Font Size\t: %dx%d\n", data[0], data[1]);
+	else
+		fprintf(o, "// Font Size\t: proportional, %d pixels high\n", font.height);
+	fprintf(o, "// Memory usage\t: %u bytes\n", (unsigned)data.size());
+	fprintf(o, "// # characters\t: %u\n\n", legacy ? data[3] : (unsigned)font.glyphs.size());
+	fprintf(o, "fontdatatype %s[%u] PROGMEM={\n", name, (unsigned)data.size());
+
+	if (legacy)
+	{
+		int per = (data[0] / 8) * data[1];
+		fprintf(o, "0x%02X,0x%02X,0x%02X,0x%02X,\n", data[0], data[1], data[2], data[3]);
+		for (int c = 0; c < data[3]; c++)
+		{
+			for (int i = 0; i < per; i++)
+				fprintf(o, "0x%02X,", data[4 + c * per + i]);
+			glyph_comment(o, data[2] + c);
+			fprintf(o, "\n");
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < data.size(); i++)
+			fprintf(o, "0x%02X,%s", data[i], ((i % 16) == 15) ? "\n" : "");
+		if (data.size() % 16)
+			fprintf(o, "\n");
+	}
+	fprintf(o, "};\n");
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: fontconv [options] font.bdf|font.ttf\n"
+		"  -f legacy|packed   output layout (default legacy)\n"
+		"  -r RANGES          codepoints to keep, e.g. 32-126,0xA0-0xFF\n"
+		"  -s PIXELS          pixel height for TrueType input (default 16)\n"
+		"  -n NAME            array name (default derived from file name)\n"
+		"  -o FILE            output file (default stdout)\n"
+		"  -d CODEPOINT       fallback glyph for unmapped codepoints\n"
+		"                     (default U+FFFD if the font has it, else '?')\n"
+		"  --raw              packed layout without RLE bitmaps\n"
+		"  --bin              write the font as a raw binary image (SPI flash)\n"
+		"  -q                 no statistics on stderr\n");
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	const char *format = "legacy", *in = 0, *outname = 0;
+	std::string name;
+	std::vector<Range> ranges;
+	int size = 16;
+	uint32_t fallback = 0;
+	bool rle = true, bin = false, quiet = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string a = argv[i];
+		if (a == "-f" && i + 1 < argc) format = argv[++i];
+		else if (a == "-r" && i + 1 < argc) ranges = parse_ranges(argv[++i]);
+		else if (a == "-s" && i + 1 < argc) size = atoi(argv[++i]);
+		else if (a == "-n" && i + 1 < argc) name = argv[++i];
+		else if (a == "-o" && i + 1 < argc) outname = argv[++i];
+		else if (a == "-d" && i + 1 < argc) fallback = strtoul(argv[++i], 0, 0);
+		else if (a == "--raw") rle = false;
+		else if (a == "--bin") bin = true;
+		else if (a == "-q") quiet = true;
+		else if (a[0] == '-') usage();
+		else in = argv[i];
+	}
+	if (!in)
+		usage();
+	bool legacy = !strcmp(format, "legacy");
+	if (!legacy && strcmp(format, "packed"))
+		usage();
+
+	if (name.empty())
+	{
+		const char *b = strrchr(in, '/');
+		name = b ? b + 1 : in;
+		name = name.substr(0, name.find('.'));
+		for (size_t i = 0; i < name.size(); i++)
+			if (!isalnum((unsigned char)name[i]))
+				name[i] = '_';
+	}
+
+	Font font;
+	const char *ext = strrchr(in, '.');
+	bool ok;
+	if (ext && !strcasecmp(ext, ".bdf"))
+		ok = load_bdf(in, ranges, font);
+	else
+	{
+#ifdef USE_FREETYPE
+		ok = load_ttf(in, size, ranges, font);
+#else
+		(void)size;
+		die("built without FreeType, only BDF input is available: ", in);
+		ok = false;
+#endif
+	}
+	if (!ok)
+		die("cannot read ", in);
+	if (font.glyphs.empty())
+		die("no glyphs in the selected ranges");
+	if (font.height > 255)
+		die("font too tall");
+	normalise(font);
+
+	Stats st;
+	std::vector<uint8_t> data = legacy ? build_legacy(font, st) : build_packed(font, fallback, rle, st);
+
+	FILE *o = outname ? fopen(outname, bin ? "wb" : "w") : stdout;
+	if (!o)
+		die("cannot write ", outname);
+	if (bin)
+		fwrite(&data[0], 1, data.size(), o);
+	else
+		write_c(o, name.c_str(), data, font, legacy);
+	if (outname)
+		fclose(o);
+
+	if (!quiet)
+	{
+		size_t n = font.glyphs.size();
+		fprintf(stderr, "glyphs           : %u\n", (unsigned)n);
+		fprintf(stderr, "line height      : %d (ascent %d)\n", font.height, font.ascent);
+		fprintf(stderr, "total size       : %u bytes\n", (unsigned)st.total);
+		fprintf(stderr, "bytes per glyph  : %.1f\n", (double)st.total / n);
+		if (!legacy)
+		{
+			fprintf(stderr, "bitmaps raw/rle  : %u / %u bytes (%s)\n", (unsigned)st.raw_bitmaps,
+				(unsigned)st.rle_bitmaps, data[2] & 1 ? "rle" : "raw");
+			fprintf(stderr, "compression      : %.2fx vs legacy layout (%u bytes)\n",
+				(double)st.legacy_equiv / st.total, (unsigned)st.legacy_equiv);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  Arduino.h - just enough of the Arduino core and the STM32 HAL for UTFT
+  to build on a PC, with the MKS TFT bus pins (see sim.cpp)
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef uint8_t		byte;
+typedef bool		boolean;
+typedef uint16_t	word;
+
+#define HIGH			1
+#define LOW				0
+#define INPUT			0
+#define OUTPUT			1
+#define INPUT_PULLUP	2
+#define RISING			3
+#define FALLING			4
+#define CHANGE			5
+#define F_CPU			72000000UL
+#define ARDUINO			10800
+#define WEAK			__attribute__((weak))
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int val);
+int digitalRead(int pin);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+void attachInterrupt(int irq, void (*isr)(void), int mode);
+void detachInterrupt(int irq);
+int digitalPinToInterrupt(int pin);
+void noInterrupts();
+void interrupts();
+volatile uint32_t *portOutputRegister(void *port);
+void *digitalPinToPort(int pin);
+uint32_t digitalPinToBitMask(int pin);
+
+class String
+{
+	public:
+		String(const char *s="") : _s(s) {}
+		const char	*c_str() const { return _s; }
+		unsigned	length() const { return strlen(_s); }
+	private:
+		const char	*_s;
+};
+
+class Stream
+{
+	public:
+		int		available() { return 0; }
+		int		read() { return -1; }
+		size_t	print(const char *s);
+		size_t	print(long v);
+		size_t	println(const char *s="");
+		size_t	println(long v);
+};
+extern Stream Serial;
+
+// GPIO registers; BSRR and BRR writes strobe the emulated bus
+struct SimBSRR { volatile uint32_t v; void operator=(uint32_t x); };
+struct SimBRR { volatile uint32_t v; void operator=(uint32_t x); };
+typedef struct { volatile uint32_t CRL, CRH, IDR, ODR; SimBSRR BSRR; SimBRR BRR; volatile uint32_t LCKR; } GPIO_TypeDef;
+typedef struct { uint32_t Pin, Mode, Pull, Speed; } GPIO_InitTypeDef;
+extern GPIO_TypeDef	*GPIOA, *GPIOB, *GPIOC, *GPIOD, *GPIOE;
+
+#define GPIO_PIN_RESET			0
+#define GPIO_PIN_SET			1
+#define GPIO_MODE_INPUT			0
+#define GPIO_MODE_OUTPUT_PP		1
+#define GPIO_MODE_OUTPUT_OD		2
+#define GPIO_MODE_IT_FALLING	7
+#define GPIO_NOPULL				0
+#define GPIO_SPEED_FREQ_MEDIUM	1
+#define GPIO_SPEED_FREQ_LOW		2
+#define GPIO_SPEED_FREQ_HIGH	3
+#define __HAL_RCC_GPIOE_CLK_ENABLE()	do {} while (0)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint32_t pin, int state);
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+
+// cycle counter that moves on by a few cycles on every read
+struct SimCycles { uint32_t v; operator uint32_t() { return v+=7; } void operator=(uint32_t x) { v=x; } };
+typedef struct { volatile uint32_t CTRL; SimCycles CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+extern DWT_Type			*DWT;
+extern CoreDebug_Type	*CoreDebug;
+extern uint32_t			SystemCoreClock;
+#define DWT_CTRL_CYCCNTENA_Msk		1
+#define CoreDebug_DEMCR_TRCENA_Msk	(1<<24)
+
+#define STM32F107xC		1
+#define MKS_TFT
+
+// MKS TFT LCD pins
+#define LCD_WR					29
+#define LCD_RS					49
+#define LCD_CS					37
+#define LCD_RD					36
+#define LCD_nWR_Pin				0x4000
+#define LCD_nWR_GPIO_Port		GPIOB
+#define LCD_RS_Pin				0x2000
+#define LCD_RS_GPIO_Port		GPIOD
+#define LCD_nRD_Pin				0x8000
+#define LCD_nRD_GPIO_Port		GPIOD
+#define LCD_nCS_Pin				0x0100
+#define LCD_nCS_GPIO_Port		GPIOC
+#define LCD_BACKLIGHT_PIN		35
+#define POWER_DI_Pin			0x0002
+#define POWER_DI_GPIO_Port		GPIOB
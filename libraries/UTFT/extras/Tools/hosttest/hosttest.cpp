@@ -0,0 +1,242 @@
+/*
+  hosttest.cpp - UTFT checks that run on a PC
+
+  Builds the library against the stub core in this directory and an
+  emulated controller (sim.cpp), draws through the normal API and compares
+  what lands in GRAM with what is expected. Prints one line per failed check
+  and exits non-zero if any failed.
+
+  Build and run (Linux), from this directory:
+    gcc -c -D__arm__ ../../../src/DefaultFonts.c
+    g++ -O1 -DUTFT_NO_RAMFUNC -I. -I../../../src -o hosttest hosttest.cpp \
+        sim.cpp ../../../src/UTFT.cpp ../../../src/UTFT_JPEG.cpp \
+        $(find ../../../src/tft_drivers -name '*.cpp') \
+        ../../../src/delay/USER_delays.c DefaultFonts.o
+    ./hosttest
+
+  Adding -fsanitize=address also catches writes past the decode buffers.
+*/
+
+#include "UTFT.h"
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+static UTFT	lcd(ILI9341_16, LCD_RS, LCD_WR, LCD_CS, LCD_RD);
+static int	failed;
+
+#define CHECK(cond, ...) \
+	do { if (!(cond)) { failed++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+// Screen (in the current orientation) to portrait GRAM
+static uint16_t pixel(int x, int y)
+{
+	if (lcd.orient==PORTRAIT)
+		return sim_fb[y][x];
+	return sim_fb[SIM_H-1-x][y];
+}
+
+static bool same_area(int x1, int y1, int x2, int y2, int w, int h)
+{
+	for (int y=0; y<h; y++)
+		for (int x=0; x<w; x++)
+			if (pixel(x1+x, y1+y)!=pixel(x2+x, y2+y))
+				return false;
+	return true;
+}
+
+// printNumI() keeps the sign in front of any filler
+static void test_print_num()
+{
+	static const struct { long num; int length; char filler; const char *text; } t[]={
+		{-42, 6, ' ', "-   42"},
+		{-42, 6, '0', "-00042"},
+		{42, 6, ' ', "    42"},
+		{-7, 0, ' ', "-7"},
+		{0, 3, '0', "000"},
+	};
+
+	lcd.setFont(SmallFont);
+	for (unsigned i=0; i<sizeof(t)/sizeof(t[0]); i++)
+	{
+		sim_reset();
+		lcd.printNumI(t[i].num, 0, 0, t[i].length, t[i].filler);
+		lcd.printStr(t[i].text, 0, 20);
+		CHECK(same_area(0, 0, 0, 20, 8*8, 12), "printNumI(%ld, %d, '%c') is not \"%s\"", t[i].num, t[i].length, t[i].filler, t[i].text);
+	}
+}
+
+// drawBitmapScaled() wider than the screen keeps its scale and is clipped
+static void test_scaled_wide()
+{
+	static const uint16_t	src[4]={RED, GREEN, BLUE, YELLOW};
+	int						w=(lcd.orient==PORTRAIT) ? SIM_W : SIM_H;
+	int						bad=0;
+
+	sim_reset();
+	lcd.drawBitmapScaled(0, 0, 4, 1, (bitmapdatatype)src, w*2, 3);
+	for (int y=0; y<3; y++)
+		for (int x=0; x<w; x++)
+			if (pixel(x, y)!=src[x*4/(w*2)])
+				bad++;
+	CHECK(bad==0, "drawBitmapScaled() %d px wide: %d pixels wrong", w*2, bad);
+	CHECK(pixel(0, 3)==0, "drawBitmapScaled() drew below its area");
+}
+
+// Indexed images: transparent index 0 splits rows into runs that start
+// inside a byte
+static uint8_t idx_at(int x, int y, int colours)
+{
+	return (x*7+y*3+x/5) % colours;
+}
+
+static void test_indexed(int bpp, bool transparent, int w, int h)
+{
+	static uint8_t	img[UTFT_IMG_HDR+2*256+37*3];
+	int				colours=1<<bpp, stride=(w*bpp+7)/8;
+	uint16_t		pal[256];
+	uint8_t			*rows=img+UTFT_IMG_HDR+2*colours;
+	int				sw=(lcd.orient==PORTRAIT) ? SIM_W : SIM_H;
+	int				bad=0;
+
+	img[0]=UTFT_IMG_INDEXED; img[1]=bpp;
+	img[2]=w; img[3]=w>>8; img[4]=h; img[5]=h>>8;
+	img[6]=colours-1; img[7]=transparent ? UTFT_IMG_TRANSPARENT : 0;
+	for (int i=0; i<colours; i++)
+	{
+		pal[i]=0x0841*(i+1);
+		img[UTFT_IMG_HDR+2*i]=pal[i]; img[UTFT_IMG_HDR+2*i+1]=pal[i]>>8;
+	}
+	memset(rows, 0, stride*h);
+	for (int y=0; y<h; y++)
+		for (int x=0; x<w; x++)
+			rows[y*stride+(x*bpp)/8]|=idx_at(x, y, colours)<<(8-bpp-(x*bpp)%8);
+
+	sim_reset();
+	lcd.setColor(RED);
+	lcd.fillRect(0, 0, sw-1, h+2);
+	lcd.drawImage(0, 1, img);
+	for (int y=0; y<h; y++)
+		for (int x=0; x<w; x++)
+		{
+			int i=idx_at(x, y, colours);
+			if (pixel(x, y+1)!=((transparent && (i==0)) ? RED : pal[i]))
+				bad++;
+		}
+	CHECK(bad==0, "drawImage() %d bpp %dx%d%s: %d pixels wrong", bpp, w, h, transparent ? " transparent" : "", bad);
+	lcd.setColor(WHITE);
+}
+
+// A damaged packed font: glyph 'A' claims 255 columns from x offset 12 and
+// 255 rows from y offset 4 in a 16x8 cell. Only the part inside the cell is
+// drawn and nothing is written past the decode buffers.
+static uint8_t bad_font[UTFT_PFONT_HDR+UTFT_PFONT_RANGE+UTFT_PFONT_GLYPH+8200];
+
+static void make_bad_font()
+{
+	uint8_t	*h=bad_font, *r=h+UTFT_PFONT_HDR, *g=r+UTFT_PFONT_RANGE;
+	int		bitmaps=g+UTFT_PFONT_GLYPH-bad_font;
+
+	h[1]=UTFT_PFONT_MAGIC; h[3]=8; h[4]=8; h[5]=16;
+	h[6]=1; h[8]=1;
+	h[12]=bitmaps; h[13]=bitmaps>>8;
+	r[0]='A'; r[4]=1;
+	g[3]=255; g[4]=255; g[5]=16; g[6]=12; g[7]=4;
+	memset(bad_font+bitmaps, 0xFF, 8200);
+}
+
+static void test_bad_glyph()
+{
+	int bad=0;
+
+	make_bad_font();
+	sim_reset();
+	lcd.setFont(bad_font);
+	lcd.printStr("A", 10, 10);
+	for (int y=0; y<8; y++)
+		for (int x=0; x<16; x++)
+			if (pixel(10+x, 10+y)!=(((x>=12) && (y>=4)) ? WHITE : BLUE))
+				bad++;
+	CHECK(bad==0, "damaged glyph: %d pixels wrong", bad);
+	CHECK(pixel(26, 14)==0, "damaged glyph drawn past its advance");
+
+	// turned half way round about its top left corner
+	sim_reset();
+	lcd.printStr("A", 30, 30, 180);
+	bad=0;
+	for (int y=0; y<8; y++)
+		for (int x=0; x<16; x++)
+			if (pixel(30-x, 30-y)!=(((x>=12) && (y>=4)) ? WHITE : BLUE))
+				bad++;
+	CHECK(bad==0, "damaged glyph rotated: %d pixels wrong", bad);
+}
+
+// Tear sync: a long run that is not the first write into its window is
+// not sent back to the window origin, and drawFrame() bands go to their
+// own rows. The emulated controller reads 0 for the scan line, so every
+// wait runs into its timeout and sets the window again.
+static void draw_stripes(UTFT *l, void *arg)
+{
+	int sw=(l->orient==PORTRAIT) ? SIM_W : SIM_H;
+	int sh=(l->orient==PORTRAIT) ? SIM_H : SIM_W;
+
+	for (int y=0; y<sh; y+=8)
+	{
+		l->setColor((y & 8) ? RED : GREEN);
+		l->fillRect(0, y, sw-1, y+7);
+	}
+	l->setColor(WHITE);
+}
+
+static void test_tear()
+{
+	static const uint8_t	img[UTFT_IMG_HDR+3*4]={
+		UTFT_IMG_RLE, 16, 100, 0, 30, 0, 0, 0,
+		9, 0x80, RED & 0xFF, RED>>8,				// 10 red
+		0xCF, 0x87, GREEN & 0xFF, GREEN>>8,		// 2000 green
+		0xDD, 0x83, BLUE & 0xFF, BLUE>>8,		// 990 blue
+	};
+	static uint16_t	ref[SIM_H][SIM_W];
+	int				bad=0;
+
+	CHECK(lcd.setTearSync(true, -1)==UTFT_TE_SCANLINE, "setTearSync() did not poll the scan line");
+	sim_reset();
+	lcd.drawImage(0, 0, img);
+	for (int y=0; y<30; y++)
+		for (int x=0; x<100; x++)
+		{
+			int i=y*100+x;
+			if (pixel(x, y)!=((i<10) ? RED : (i<2010) ? GREEN : BLUE))
+				bad++;
+		}
+	CHECK(bad==0, "RLE image with tear sync: %d pixels wrong", bad);
+
+	sim_reset();
+	lcd.drawFrame(draw_stripes);
+	memcpy(ref, sim_fb, sizeof(ref));
+	lcd.setTearSync(false, -1);
+	sim_reset();
+	lcd.drawFrame(draw_stripes);
+	CHECK(memcmp(ref, sim_fb, sizeof(ref))==0, "drawFrame() with tear sync differs from without");
+}
+
+int main()
+{
+	for (int o=0; o<2; o++)
+	{
+		lcd.Init(o ? LANDSCAPE : PORTRAIT);
+		lcd.setColor(WHITE);
+		lcd.setBackColor(BLUE);
+		test_print_num();
+		test_scaled_wide();
+		test_bad_glyph();
+		test_tear();
+		for (int bpp=1; bpp<=8; bpp*=2)
+		{
+			test_indexed(bpp, true, 37, 3);
+			test_indexed(bpp, false, 37, 3);
+		}
+	}
+	printf("%s\n", failed ? "FAILED" : "OK");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+/*
+  sim.cpp - PC emulation of the MKS TFT LCD bus: GPIOE carries the data,
+  a rising nWR edge latches it, RS tells commands from data. Column and page
+  address set (2A/2B) and memory write (2C) are all the controller does;
+  reads return 0.
+*/
+
+#include "Arduino.h"
+#include "sim.h"
+#include <stdio.h>
+
+static GPIO_TypeDef		ga, gb, gc, gd, ge;
+GPIO_TypeDef			*GPIOA=&ga, *GPIOB=&gb, *GPIOC=&gc, *GPIOD=&gd, *GPIOE=&ge;
+static DWT_Type			dwt;
+static CoreDebug_Type	cdb;
+DWT_Type				*DWT=&dwt;
+CoreDebug_Type			*CoreDebug=&cdb;
+uint32_t				SystemCoreClock=72000000;
+Stream					Serial;
+
+size_t Stream::print(const char *s) { return printf("%s", s); }
+size_t Stream::print(long v) { return printf("%ld", v); }
+size_t Stream::println(const char *s) { return printf("%s\n", s); }
+size_t Stream::println(long v) { return printf("%ld\n", v); }
+
+static volatile uint32_t	dummy;
+static unsigned long		now_us;
+
+void pinMode(int pin, int mode) {}
+void digitalWrite(int pin, int val) {}
+int digitalRead(int pin) { return 0; }
+void delay(unsigned long ms) { now_us+=ms*1000; }
+void delayMicroseconds(unsigned int us) { now_us+=us; }
+unsigned long millis() { return (now_us+=1000)/1000; }
+unsigned long micros() { return ++now_us; }
+void attachInterrupt(int irq, void (*isr)(void), int mode) {}
+void detachInterrupt(int irq) {}
+int digitalPinToInterrupt(int pin) { return pin; }
+void noInterrupts() {}
+void interrupts() {}
+volatile uint32_t *portOutputRegister(void *port) { return &dummy; }
+void *digitalPinToPort(int pin) { return 0; }
+uint32_t digitalPinToBitMask(int pin) { return 1; }
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init) {}
+
+uint16_t	sim_fb[SIM_H][SIM_W];
+
+static int		rs=1, wr=1, cmd=-1, argn;
+static uint8_t	args[4];
+static int		xs, xe=SIM_W-1, ys, ye=SIM_H-1, cx, cy;
+
+void sim_reset()
+{
+	memset(sim_fb, 0, sizeof(sim_fb));
+}
+
+static void _write(uint16_t d)
+{
+	if (!rs)
+	{
+		cmd=d & 0xFF;
+		argn=0;
+		cx=xs;
+		cy=ys;
+		return;
+	}
+	if (cmd==0x2C)
+	{
+		if ((cx<SIM_W) && (cy<SIM_H))
+			sim_fb[cy][cx]=d;
+		if (++cx>xe)
+		{
+			cx=xs;
+			if (++cy>ye)
+				cy=ys;
+		}
+		return;
+	}
+	if (argn<4)
+		args[argn++]=d;
+	if ((cmd==0x2A) && (argn==4))
+	{
+		xs=(args[0]<<8) | args[1];
+		xe=(args[2]<<8) | args[3];
+	}
+	if ((cmd==0x2B) && (argn==4))
+	{
+		ys=(args[0]<<8) | args[1];
+		ye=(args[2]<<8) | args[3];
+	}
+}
+
+static void _pin(GPIO_TypeDef *port, uint32_t pin, int state)
+{
+	if ((port==GPIOD) && (pin==LCD_RS_Pin))
+		rs=state;
+	else if ((port==GPIOB) && (pin==LCD_nWR_Pin))
+	{
+		if ((!wr) && (state))
+			_write(GPIOE->ODR);
+		wr=state;
+	}
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint32_t pin, int state)
+{
+	_pin(port, pin, state);
+}
+
+void SimBSRR::operator=(uint32_t x)
+{
+	GPIO_TypeDef *port=(GPIO_TypeDef *)((char *)this-offsetof(GPIO_TypeDef, BSRR));
+
+	for (int b=0; b<16; b++)
+	{
+		if (x & (1u<<b))
+			_pin(port, 1u<<b, 1);
+		if (x & (1u<<(b+16)))
+			_pin(port, 1u<<b, 0);
+	}
+}
+
+void SimBRR::operator=(uint32_t x)
+{
+	GPIO_TypeDef *port=(GPIO_TypeDef *)((char *)this-offsetof(GPIO_TypeDef, BRR));
+
+	for (int b=0; b<16; b++)
+		if (x & (1u<<b))
+			_pin(port, 1u<<b, 0);
+}
@@ -0,0 +1,14 @@
+/*
+  sim.h - PC emulation of the MKS TFT LCD bus and a 240x320 MIPI DCS
+  (ILI9341 style) controller, for the host tests
+*/
+
+#pragma once
+#include <stdint.h>
+
+#define SIM_W	240
+#define SIM_H	320
+
+extern uint16_t	sim_fb[SIM_H][SIM_W];	// GRAM, portrait
+
+void sim_reset();
@@ -0,0 +1,371 @@
+/*
+  imgpack.cpp - host side image compiler for UTFT::drawImage()
+
+  Converts BMP (24/32 bit, uncompressed), binary PPM (P6) or raw RGB565
+  images (as written by ImageConverter565, needs -w) into the compressed
+  image layouts understood by UTFT::drawImage():
+
+    indexed - palette of up to 256 RGB565 colours followed by rows of
+              1, 2, 4 or 8 bit indices, the smallest depth that holds
+              the palette is used
+    rle     - run length coded RGB565 for flat colour backgrounds and
+              splash screens, decoded straight to the bus
+
+  Build (Linux):
+    g++ -O2 -o imgpack imgpack.cpp
+
+  Examples:
+    imgpack -n icon_home home.bmp > icon_home.c
+    imgpack -t FF00FF -n needle needle.ppm > needle.c
+    imgpack -w 32 -n fan fan.raw > fan.c
+    imgpack -f rle -n splash splash.bmp > splash.c
+
+  Indexed layout (all multi-byte fields little endian):
+
+    0   'I'       format
+    1   bpp       bits per pixel: 1, 2, 4 or 8
+    2   width     u16
+    4   height    u16
+    6   colours   number of palette entries - 1
+    7   flags     bit0: palette entry 0 is transparent
+    8   palette   colours * u16 RGB565
+        pixels    height rows of width indices, MSB first, each row
+                  padded to a whole byte
+
+  RLE layout (little endian 16 bit words):
+
+    0   'R', 16   format, bits per pixel
+    2   width
+    4   height
+    6   0         reserved
+    8   codes     pixels in raster order, runs may cross rows:
+                  0x8000 | (n-1), colour       n pixels of one colour
+                  n-1, colour * n              n literal pixels
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <map>
+
+struct Image
+{
+	int		w, h;
+	std::vector<uint16_t> px;	// RGB565, row-major
+};
+
+static void die(const char *msg, const char *arg = "")
+{
+	fprintf(stderr, "imgpack: %s%s\n", msg, arg);
+	exit(1);
+}
+
+static uint16_t rgb565(int r, int g, int b)
+{
+	return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+static std::vector<uint8_t> read_file(const char *path)
+{
+	std::vector<uint8_t> d;
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		die("cannot read ", path);
+	uint8_t buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		d.insert(d.end(), buf, buf + n);
+	fclose(f);
+	return d;
+}
+
+static uint32_t le(const std::vector<uint8_t> &d, size_t o, int n)
+{
+	uint32_t v = 0;
+	for (int i = n - 1; i >= 0; i--)
+		v = (v << 8) | d[o + i];
+	return v;
+}
+
+static bool load_bmp(const std::vector<uint8_t> &d, Image &img)
+{
+	if (d.size() < 54 || d[0] != 'B' || d[1] != 'M')
+		return false;
+	uint32_t off = le(d, 10, 4);
+	int32_t w = (int32_t)le(d, 18, 4), h = (int32_t)le(d, 22, 4);
+	int bpp = le(d, 28, 2), comp = le(d, 30, 4);
+	if ((bpp != 24 && bpp != 32) || (comp != 0 && comp != 3))
+		die("only uncompressed 24/32 bit BMP files are supported");
+	bool topdown = h < 0;
+	if (topdown)
+		h = -h;
+	size_t stride = ((size_t)w * (bpp / 8) + 3) & ~3;
+	if (off + stride * h > d.size())
+		die("truncated BMP file");
+	img.w = w;
+	img.h = h;
+	img.px.resize((size_t)w * h);
+	for (int y = 0; y < h; y++)
+	{
+		const uint8_t *r = &d[off + stride * (topdown ? y : h - 1 - y)];
+		for (int x = 0; x < w; x++, r += bpp / 8)
+			img.px[(size_t)y * w + x] = rgb565(r[2], r[1], r[0]);
+	}
+	return true;
+}
+
+static bool load_ppm(const std::vector<uint8_t> &d, Image &img)
+{
+	if (d.size() < 2 || d[0] != 'P' || d[1] != '6')
+		return false;
+	size_t p = 2;
+	int v[3];
+	for (int i = 0; i < 3; i++)
+	{
+		while (p < d.size() && (isspace(d[p]) || d[p] == '#'))
+		{
+			if (d[p] == '#')
+				while (p < d.size() && d[p] != '\n')
+					p++;
+			p++;
+		}
+		v[i] = 0;
+		while (p < d.size() && isdigit(d[p]))
+			v[i] = v[i] * 10 + (d[p++] - '0');
+	}
+	p++;
+	if (v[2] != 255)
+		die("only 8 bit PPM files are supported");
+	img.w = v[0];
+	img.h = v[1];
+	if (p + (size_t)img.w * img.h * 3 > d.size())
+		die("truncated PPM file");
+	img.px.resize((size_t)img.w * img.h);
+	for (size_t i = 0; i < img.px.size(); i++, p += 3)
+		img.px[i] = rgb565(d[p], d[p + 1], d[p + 2]);
+	return true;
+}
+
+static void load_raw(const std::vector<uint8_t> &d, int w, Image &img)
+{
+	if (w <= 0 || d.size() % (2 * w))
+		die("raw RGB565 input needs -w with the image width");
+	img.w = w;
+	img.h = d.size() / (2 * w);
+	img.px.resize((size_t)img.w * img.h);
+	for (size_t i = 0; i < img.px.size(); i++)
+		img.px[i] = (d[2 * i] << 8) | d[2 * i + 1];	// ImageConverter565 .raw is high byte first
+}
+
+static void put16(std::vector<uint8_t> &v, uint32_t x)
+{
+	v.push_back(x & 0xFF);
+	v.push_back((x >> 8) & 0xFF);
+}
+
+static std::vector<uint8_t> build_indexed(const Image &img, int transparent, int force_bpp)
+{
+	// palette in order of first use, the transparent colour always first
+	std::vector<uint16_t> pal;
+	std::map<uint16_t, int> index;
+	if (transparent >= 0)
+	{
+		index[transparent] = 0;
+		pal.push_back(transparent);
+	}
+	for (size_t i = 0; i < img.px.size(); i++)
+		if (!index.count(img.px[i]))
+		{
+			index[img.px[i]] = pal.size();
+			pal.push_back(img.px[i]);
+		}
+	if (pal.size() > 256)
+	{
+		fprintf(stderr, "imgpack: %u colours, reduce the image to 256 or fewer first\n", (unsigned)pal.size());
+		exit(1);
+	}
+
+	int bpp = pal.size() <= 2 ? 1 : pal.size() <= 4 ? 2 : pal.size() <= 16 ? 4 : 8;
+	if (force_bpp)
+	{
+		if (force_bpp < bpp)
+			die("the palette does not fit the requested depth");
+		bpp = force_bpp;
+	}
+
+	std::vector<uint8_t> out;
+	out.push_back('I');
+	out.push_back(bpp);
+	put16(out, img.w);
+	put16(out, img.h);
+	out.push_back(pal.size() - 1);
+	out.push_back(transparent >= 0 ? 1 : 0);
+	for (size_t i = 0; i < pal.size(); i++)
+		put16(out, pal[i]);
+	for (int y = 0; y < img.h; y++)
+	{
+		int acc = 0, bits = 0;
+		for (int x = 0; x < img.w; x++)
+		{
+			acc = (acc << bpp) | index[img.px[(size_t)y * img.w + x]];
+			bits += bpp;
+			if (bits == 8)
+			{
+				out.push_back(acc);
+				acc = bits = 0;
+			}
+		}
+		if (bits)
+			out.push_back(acc << (8 - bits));
+	}
+	return out;
+}
+
+static std::vector<uint8_t> build_rle(const Image &img)
+{
+	std::vector<uint8_t> out;
+	out.push_back('R');
+	out.push_back(16);
+	put16(out, img.w);
+	put16(out, img.h);
+	put16(out, 0);
+
+	const std::vector<uint16_t> &px = img.px;
+	size_t i = 0, lit, n = px.size();
+	while (i < n)
+	{
+		size_t run = 1;
+		while (i + run < n && px[i + run] == px[i] && run < 0x8000)
+			run++;
+		// literals only stop for three equal pixels, a pair is coded as a
+		// run when it does not split a literal
+		if (run >= 2)
+		{
+			put16(out, 0x8000 | (run - 1));
+			put16(out, px[i]);
+			i += run;
+			continue;
+		}
+		size_t start = i;
+		for (lit = 0; i < n && lit < 0x8000; i++, lit++)
+			if (i + 2 < n && px[i] == px[i + 1] && px[i] == px[i + 2])
+				break;
+		put16(out, lit - 1);
+		for (size_t k = start; k < i; k++)
+			put16(out, px[k]);
+	}
+	return out;
+}
+
+static void write_c(FILE *o, const char *name, const std::vector<uint8_t> &data, const Image &img, const char *format)
+{
+	fprintf(o, "#if defined(__AVR__)\n"
+	           "\t#include <avr/pgmspace.h>\n"
+	           "#elif defined(__PIC32MX__) || defined(__arm__)\n"
+	           "\t#define PROGMEM\n"
+	           "#endif\n\n");
+	fprintf(o, "// %s.c\n", name);
+	fprintf(o, "// Image Size\t: %dx%d, %s\n", img.w, img.h, format);
+	fprintf(o, "// Memory usage\t: %u bytes (RGB565 %u bytes)\n\n", (unsigned)data.size(), (unsigned)img.px.size() * 2);
+	fprintf(o, "const unsigned char %s[%u] PROGMEM={\n", name, (unsigned)data.size());
+	for (size_t i = 0; i < data.size(); i++)
+		fprintf(o, "0x%02X,%s", data[i], ((i % 16) == 15) ? "\n" : "");
+	if (data.size() % 16)
+		fprintf(o, "\n");
+	fprintf(o, "};\n");
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: imgpack [options] image.bmp|image.ppm|image.raw\n"
+		"  -f indexed|rle     output layout (default indexed)\n"
+		"  -b BPP             force 1, 2, 4 or 8 bits per pixel\n"
+		"  -t RRGGBB          colour that is not drawn\n"
+		"  -w WIDTH           image width for raw RGB565 input\n"
+		"  -n NAME            array name (default derived from file name)\n"
+		"  -o FILE            output file (default stdout)\n"
+		"  --bin              write the image as a raw binary (SD card, SPI flash)\n"
+		"  -q                 no statistics on stderr\n");
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	const char *format = "indexed", *in = 0, *outname = 0;
+	std::string name;
+	int transparent = -1, force_bpp = 0, width = 0;
+	bool bin = false, quiet = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string a = argv[i];
+		if (a == "-f" && i + 1 < argc) format = argv[++i];
+		else if (a == "-b" && i + 1 < argc) force_bpp = atoi(argv[++i]);
+		else if (a == "-t" && i + 1 < argc)
+		{
+			uint32_t c = strtoul(argv[++i], 0, 16);
+			transparent = rgb565(c >> 16, (c >> 8) & 0xFF, c & 0xFF);
+		}
+		else if (a == "-w" && i + 1 < argc) width = atoi(argv[++i]);
+		else if (a == "-n" && i + 1 < argc) name = argv[++i];
+		else if (a == "-o" && i + 1 < argc) outname = argv[++i];
+		else if (a == "--bin") bin = true;
+		else if (a == "-q") quiet = true;
+		else if (a[0] == '-') usage();
+		else in = argv[i];
+	}
+	bool rle = !strcmp(format, "rle");
+	if (!in || (!rle && strcmp(format, "indexed")))
+		usage();
+	if (force_bpp && force_bpp != 1 && force_bpp != 2 && force_bpp != 4 && force_bpp != 8)
+		usage();
+
+	if (name.empty())
+	{
+		const char *b = strrchr(in, '/');
+		name = b ? b + 1 : in;
+		name = name.substr(0, name.find('.'));
+		for (size_t i = 0; i < name.size(); i++)
+			if (!isalnum((unsigned char)name[i]))
+				name[i] = '_';
+	}
+
+	Image img;
+	std::vector<uint8_t> d = read_file(in);
+	if (!load_bmp(d, img) && !load_ppm(d, img))
+		load_raw(d, width, img);
+	if (img.w <= 0 || img.h <= 0 || img.w > 0xFFFF || img.h > 0xFFFF)
+		die("bad image size in ", in);
+
+	if (rle && transparent >= 0)
+		die("RLE images have no transparent colour");
+	std::vector<uint8_t> data = rle ? build_rle(img) : build_indexed(img, transparent, force_bpp);
+
+	FILE *o = outname ? fopen(outname, bin ? "wb" : "w") : stdout;
+	if (!o)
+		die("cannot write ", outname);
+	if (bin)
+		fwrite(&data[0], 1, data.size(), o);
+	else
+		write_c(o, name.c_str(), data, img, format);
+	if (outname)
+		fclose(o);
+
+	if (!quiet)
+	{
+		fprintf(stderr, "image            : %dx%d\n", img.w, img.h);
+		if (rle)
+			fprintf(stderr, "layout           : rle\n");
+		else
+			fprintf(stderr, "layout           : indexed, %d bpp, %d colours\n", data[1], data[6] + 1);
+		fprintf(stderr, "total size       : %u bytes\n", (unsigned)data.size());
+		fprintf(stderr, "compression      : %.2fx vs RGB565 (%u bytes)\n",
+			(double)img.px.size() * 2 / data.size(), (unsigned)img.px.size() * 2);
+	}
+	return 0;
+}
@@ -0,0 +1,278 @@
+/*
+  jpegcheck.cpp - compares UTFT_JPEG with libjpeg on a PC
+
+  Decodes baseline JPEGs with the library decoder (src/UTFT_JPEG.cpp) and
+  with libjpeg (integer IDCT, plain upsampling), converts both to RGB565
+  and reports the largest and the mean difference per channel, in RGB565
+  steps. Without file arguments a test picture is encoded by libjpeg as
+  grey, 4:4:4, 4:2:2, 4:4:0 and 4:2:0, and 4:2:0 with restart markers.
+  Exits non-zero if any image is off by more than the tolerance, or
+  drifts one way on average (a rounding bias).
+
+  Build (Linux, needs libjpeg-dev):
+    g++ -O2 -I../../../src -o jpegcheck jpegcheck.cpp ../../../src/UTFT_JPEG.cpp -ljpeg
+
+  Examples:
+    jpegcheck
+    jpegcheck -t 2 photo.jpg splash.jpg
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <jpeglib.h>
+#include "UTFT_JPEG.h"
+
+#define TEST_W		75		// not a whole number of MCUs
+#define TEST_H		53
+#define MAX_BIAS	0.1		// mean signed difference allowed, RGB565 steps
+
+struct Target
+{
+	int						w, h;
+	std::vector<uint16_t>	px;
+};
+
+// Both decoder callbacks get the same io pointer
+struct Job
+{
+	const uint8_t	*data;
+	size_t			len, pos;
+	Target			*t;
+};
+
+static int read_mem(void *io, uint8_t *buf, int len)
+{
+	Job *j=(Job *)io;
+
+	if ((size_t)len>j->len-j->pos)
+		len=j->len-j->pos;
+	memcpy(buf, j->data+j->pos, len);
+	j->pos+=len;
+	return len;
+}
+
+static void put_block(void *io, int x, int y, int w, int h, const uint16_t *pix)
+{
+	Target *t=((Job *)io)->t;
+
+	for (int j=0; j<h; j++)
+		for (int i=0; i<w; i++)
+			if ((x+i<t->w) && (y+j<t->h))
+				t->px[(y+j)*t->w+x+i]=pix[j*w+i];
+}
+
+static uint16_t rgb565(int r, int g, int b)
+{
+	return ((r & 0xF8)<<8) | ((g & 0xFC)<<3) | (b>>3);
+}
+
+static int decode_utft(const std::vector<uint8_t> &jpg, Target *t)
+{
+	static UTFT_JPEG	dec;
+	Job					job={jpg.data(), jpg.size(), 0, t};
+	int					res;
+
+	res=dec.begin(read_mem, &job);
+	if (res!=UTFT_JPEG_OK)
+		return res;
+	t->w=dec.getWidth();
+	t->h=dec.getHeight();
+	t->px.assign(t->w*t->h, 0);
+	return dec.decode(put_block);
+}
+
+static bool decode_ref(const std::vector<uint8_t> &jpg, Target *t)
+{
+	jpeg_decompress_struct	cinfo;
+	jpeg_error_mgr			jerr;
+	std::vector<uint8_t>	row;
+
+	cinfo.err=jpeg_std_error(&jerr);
+	jpeg_create_decompress(&cinfo);
+	jpeg_mem_src(&cinfo, (unsigned char *)jpg.data(), jpg.size());
+	if (jpeg_read_header(&cinfo, TRUE)!=JPEG_HEADER_OK)
+	{
+		jpeg_destroy_decompress(&cinfo);
+		return false;
+	}
+	cinfo.out_color_space=JCS_RGB;
+	cinfo.dct_method=JDCT_ISLOW;
+	cinfo.do_fancy_upsampling=FALSE;
+	jpeg_start_decompress(&cinfo);
+	t->w=cinfo.output_width;
+	t->h=cinfo.output_height;
+	t->px.resize(t->w*t->h);
+	row.resize(t->w*3);
+	while (cinfo.output_scanline<cinfo.output_height)
+	{
+		uint8_t	*p=row.data();
+		int		y=cinfo.output_scanline;
+
+		jpeg_read_scanlines(&cinfo, &p, 1);
+		for (int x=0; x<t->w; x++)
+			t->px[y*t->w+x]=rgb565(row[x*3], row[x*3+1], row[x*3+2]);
+	}
+	jpeg_finish_decompress(&cinfo);
+	jpeg_destroy_decompress(&cinfo);
+	return true;
+}
+
+// Smooth ramps, hard edges and saturated corners that push the colour
+// conversion into its clamps
+static std::vector<uint8_t> encode_test(int ncomp, int hs, int vs, int restart)
+{
+	jpeg_compress_struct	cinfo;
+	jpeg_error_mgr			jerr;
+	unsigned char			*out=NULL;
+	unsigned long			len=0;
+	std::vector<uint8_t>	row(TEST_W*3);
+
+	cinfo.err=jpeg_std_error(&jerr);
+	jpeg_create_compress(&cinfo);
+	jpeg_mem_dest(&cinfo, &out, &len);
+	cinfo.image_width=TEST_W;
+	cinfo.image_height=TEST_H;
+	cinfo.input_components=ncomp;
+	cinfo.in_color_space=(ncomp==1) ? JCS_GRAYSCALE : JCS_RGB;
+	jpeg_set_defaults(&cinfo);
+	jpeg_set_quality(&cinfo, 90, TRUE);
+	cinfo.restart_interval=restart;
+	if (ncomp==3)
+	{
+		cinfo.comp_info[0].h_samp_factor=hs;
+		cinfo.comp_info[0].v_samp_factor=vs;
+	}
+	jpeg_start_compress(&cinfo, TRUE);
+	while (cinfo.next_scanline<cinfo.image_height)
+	{
+		int		y=cinfo.next_scanline;
+		uint8_t	*p=row.data();
+
+		for (int x=0; x<TEST_W; x++)
+		{
+			int r=x*255/(TEST_W-1), g=y*255/(TEST_H-1), b=((x/8+y/8) & 1) ? 230 : 20;
+
+			if ((x<12) && (y<12))
+				r=255, g=0, b=0;
+			else if ((x>=TEST_W-12) && (y<12))
+				r=0, g=255, b=0;
+			else if ((x<12) && (y>=TEST_H-12))
+				r=0, g=0, b=255;
+			if (ncomp==1)
+				row[x]=(r*77+g*150+b*29)>>8;
+			else
+			{
+				row[x*3]=r;
+				row[x*3+1]=g;
+				row[x*3+2]=b;
+			}
+		}
+		jpeg_write_scanlines(&cinfo, &p, 1);
+	}
+	jpeg_finish_compress(&cinfo);
+	jpeg_destroy_compress(&cinfo);
+	std::vector<uint8_t> jpg(out, out+len);
+	free(out);
+	return jpg;
+}
+
+static bool load(const char *name, std::vector<uint8_t> *jpg)
+{
+	FILE	*f=fopen(name, "rb");
+	int		c;
+
+	if (!f)
+		return false;
+	while ((c=fgetc(f))!=EOF)
+		jpg->push_back(c);
+	fclose(f);
+	return true;
+}
+
+// Returns false if the two decodes disagree by more than tol
+static bool check(const char *name, const std::vector<uint8_t> &jpg, int tol)
+{
+	static const int	shift[3]={11, 5, 0}, mask[3]={0x1F, 0x3F, 0x1F};
+	static const char	*chan[3]={"R", "G", "B"};
+	Target				got, ref;
+	int					res, maxd[3]={0, 0, 0};
+	double				sum[3]={0, 0, 0}, bias[3]={0, 0, 0};
+	bool				ok=true;
+
+	if (!decode_ref(jpg, &ref))
+	{
+		printf("%-12s not readable by libjpeg\n", name);
+		return false;
+	}
+	res=decode_utft(jpg, &got);
+	if (res!=UTFT_JPEG_OK)
+	{
+		printf("%-12s UTFT_JPEG error %d\n", name, res);
+		return false;
+	}
+	if ((got.w!=ref.w) || (got.h!=ref.h))
+	{
+		printf("%-12s size %dx%d, libjpeg %dx%d\n", name, got.w, got.h, ref.w, ref.h);
+		return false;
+	}
+	for (size_t i=0; i<got.px.size(); i++)
+		for (int c=0; c<3; c++)
+		{
+			int d=((got.px[i]>>shift[c]) & mask[c])-((ref.px[i]>>shift[c]) & mask[c]);
+
+			bias[c]+=d;
+			sum[c]+=abs(d);
+			if (abs(d)>maxd[c])
+				maxd[c]=abs(d);
+		}
+	printf("%-12s %dx%d", name, got.w, got.h);
+	for (int c=0; c<3; c++)
+	{
+		bias[c]/=got.px.size();
+		printf("  %s max %d mean %.3f bias %+.3f", chan[c], maxd[c], sum[c]/got.px.size(), bias[c]);
+		if ((maxd[c]>tol) || (fabs(bias[c])>MAX_BIAS))
+			ok=false;
+	}
+	printf("%s\n", ok ? "" : "  FAIL");
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	static const struct { const char *name; int ncomp, hs, vs, restart; } t[]={
+		{"grey", 1, 1, 1, 0},
+		{"4:4:4", 3, 1, 1, 0},
+		{"4:2:2", 3, 2, 1, 0},
+		{"4:4:0", 3, 1, 2, 0},
+		{"4:2:0", 3, 2, 2, 0},
+		{"4:2:0 RST", 3, 2, 2, 3},
+	};
+	int		tol=1, i, failed=0, files=0;
+
+	for (i=1; i<argc; i++)
+	{
+		std::vector<uint8_t> jpg;
+
+		if ((strcmp(argv[i], "-t")==0) && (i+1<argc))
+		{
+			tol=atoi(argv[++i]);
+			continue;
+		}
+		files++;
+		if (!load(argv[i], &jpg))
+		{
+			printf("%-12s cannot open\n", argv[i]);
+			failed++;
+		}
+		else if (!check(argv[i], jpg, tol))
+			failed++;
+	}
+	if (files==0)
+		for (i=0; i<(int)(sizeof(t)/sizeof(t[0])); i++)
+			if (!check(t[i].name, encode_test(t[i].ncomp, t[i].hs, t[i].vs, t[i].restart), tol))
+				failed++;
+	return failed ? 1 : 0;
+}
@@ -39,9 +39,44 @@
 // Include hardware-specific functions for the correct MCU
 
 #include "UTFT.h"
-//#include "delay/user_delay.h"
+#include "delay/User_delay.h"
 #include <hardware/arm/HW_STM32F.h>
-#include "memorysaver.h"
+
+// Driver descriptors, from tft_drivers/*/driver.cpp (UTFT_DRIVER())
+extern const UTFT_Driver	__start_utft_drivers[], __stop_utft_drivers[];
+
+// initAsync() progress
+#define INIT_DONE		0
+#define INIT_PROBE		1		// controller reset, waiting to read its ID
+#define INIT_TABLE		2		// _init_pos is the next init table entry
+
+static const UTFT_Driver *_init_by_id(uint16_t id)
+{
+	for (const UTFT_Driver *d=__start_utft_drivers; d<__stop_utft_drivers; d++)
+		if ((d->id!=0) && (d->id==id))
+			return d;
+	return 0;
+}
+
+static const UTFT_Driver *_driver_by_model(byte model)
+{
+	for (const UTFT_Driver *d=__start_utft_drivers; d<__stop_utft_drivers; d++)
+		if (d->model==model)
+			return d;
+	return 0;
+}
+
+static void _setxy_none(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+}
+
+// Address window routine of a model, resolved once instead of on every setXY()
+static UTFT_SetXY _setxy_by_model(byte model)
+{
+	const UTFT_Driver	*d=_driver_by_model(model);
+
+	return (d) ? d->setxy : _setxy_none;
+}
 
 
 
@@ -52,35 +87,48 @@ UTFT::UTFT(byte model,uint16_t Xsize,uint16_t Ysize,byte trmodel)  //for ILI9486
 	disp_x_size =			Xsize;
 	disp_y_size =			Ysize;
 	display_transfer_mode =	trmodel;
+	_store =				0;
+	_bus_profile =			UTFT_BUS_DEFAULT;
+	_bus_pad =				_bus_profiles[UTFT_BUS_DEFAULT].pad;
+	_page =					0;
+	_band =					0;
+	_tear =					UTFT_TE_OFF;
+	_tear_origin =			false;
+	_setxy =				_setxy_by_model(model);
 }
 
 
 
 UTFT::UTFT()
 {
+	_store =				0;
+	_bus_profile =			UTFT_BUS_DEFAULT;
+	_bus_pad =				_bus_profiles[UTFT_BUS_DEFAULT].pad;
+	_page =					0;
+	_band =					0;
+	_tear =					UTFT_TE_OFF;
+	_tear_origin =			false;
+	_setxy =				_setxy_none;
 }
 
 #endif
 #ifndef FSMC_TFT
 UTFT::UTFT(byte model, int RS, int WR, int CS, int RST, int SER)
 { 
-	uint16_t	dsx[] = {239, 239, 239, 239, 239, 239, 175, 175, 239, 127,		// 00-09
-					 127, 239, 271, 479, 239, 239, 239, 239, 0, 239,			// 10-19
-					 479, 319, 239, 175, 127, 239, 239, 319, 319, 799,		// 20-29
-					 239, 127,239};												// 30-
-	uint16_t	dsy[] = {319, 399, 319, 319, 319, 319, 219, 219, 399, 159,		// 00-09
-					 127, 319, 479, 799, 319, 319, 319, 319, 0, 319,			// 10-19
-					 799, 479, 319, 219, 159, 319, 319, 479, 479, 479,		// 20-29
-					 319, 159,399};												// 30-
-	byte	dtm[] = {16, 16, 16, 8, 8, 16, 8, SERIAL_4PIN, 16, SERIAL_5PIN,					// 00-09
-					 SERIAL_5PIN, 16, 16, 16, 8, 16, LATCHED_16, 16, 0, 8,					// 10-19
-					 16, 16, 16, 8, SERIAL_5PIN, SERIAL_5PIN, SERIAL_4PIN, 16, 16, 16,		// 20-29
-					 8, SERIAL_5PIN,16};												// 30-
+	const UTFT_Driver	*d=_driver_by_model((model==UTFT_AUTO) ? UTFT_AUTO_FALLBACK : model);
 
 	display_model =			model;	
-	disp_x_size =			dsx[model];
-	disp_y_size =			dsy[model];
-	display_transfer_mode =	dtm[model];
+	disp_x_size =			(d) ? d->xsize : 0;
+	disp_y_size =			(d) ? d->ysize : 0;
+	display_transfer_mode =	(d) ? d->mode : 0;
+	_store =				0;
+	_bus_profile =			UTFT_BUS_DEFAULT;
+	_bus_pad =				_bus_profiles[UTFT_BUS_DEFAULT].pad;
+	_page =					0;
+	_band =					0;
+	_tear =					UTFT_TE_OFF;
+	_tear_origin =			false;
+	_setxy =				_setxy_by_model(model);
     
 	__p1 = RS;
 	__p2 = WR;
@@ -191,6 +239,9 @@ void UTFT::LCD_Write_COM_DATA(char com1,int dat1)
 #endif
 
 #define delay_ms(x) delay(x)
+
+static const uint32_t _pow10[10]={1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
 #ifdef __USER_DELAY_H__
   #define LCD_delay_ms(x) USER_delay_ms(x)
 #else
@@ -211,7 +262,297 @@ int  UTFT::readID(void)
    return 	(uint16_t)(second_read);
 }			  
 
+// Sends init table entries up to the next delay or the end, see UTFT_INIT_*
+// in UTFT.h. Returns where to go on after the delay, whose length is put in
+// ms, or 0 at the end of the table.
+const uint8_t *UTFT::_init_step(const uint8_t *t, uint16_t *ms)
+{
+	byte	h, n;
+	int		cmd;
+
+	while ((h=pgm_read_byte(t++))!=UTFT_INIT_END)
+	{
+		if (h==UTFT_INIT_DELAY)
+		{
+			*ms=pgm_read_byte(t++);
+			return t;
+		}
+		n=h & UTFT_INIT_ARGS;
+		if (h & UTFT_INIT_WORDS)
+		{
+			cmd=(pgm_read_byte(&t[0])<<8) | pgm_read_byte(&t[1]);
+			LCD_Write_COM(cmd);
+			for (t+=2; n>0; n--, t+=2)
+				LCD_Write_DATA(pgm_read_byte(&t[0]), pgm_read_byte(&t[1]));
+		}
+		else
+		{
+			LCD_Write_COM(pgm_read_byte(t++));
+			for (; n>0; n--)
+				LCD_Write_DATA(pgm_read_byte(t++));
+		}
+	}
+	return 0;
+}
+
+void UTFT::_init_table(const uint8_t *t)
+{
+	uint16_t	ms;
+
+	while ((t=_init_step(t, &ms))!=0)
+		delay(ms);
+}
+
+// Reads n words of the answer to cmd, dummy word included
+void UTFT::_read_reg(int cmd, uint16_t *buf, int n)
+{
+	LCD_Write_COM(cmd);
+#if defined(STM32F107xC)
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_SET);
+	set_register(1);
+#endif
+	_read_burst(buf, n);
+#if defined(STM32F107xC)
+	set_register(0);
+#endif
+}
+
+// ID registers tried by _probe_id(): words read including the dummy, and
+// the words holding the high and low byte of the ID (the same one for a
+// 16 bit ID)
+struct _id_reg
+{
+	uint16_t	reg;
+	byte		words, hi, lo;
+};
+
+static const _id_reg _id_regs[] = {
+	{0x00, 1, 0, 0},		// ILI932x, SPFD5420, SSD1289, HX8347A
+	{0xD3, 4, 2, 3},		// ILI9341, ILI9486: dummy, 00, 93, 41
+	{0xBF, 5, 3, 4},		// ILI9481, ILI6804: dummy, 02, 04, 94, 81
+	{0xD4, 4, 2, 3},		// NT35310: dummy, 01, 53, 10
+};
+
+#define ID_REGS		(sizeof(_id_regs)/sizeof(_id_regs[0]))
+
+uint16_t UTFT::_read_id(byte n)
+{
+	uint16_t	r[5];
+
+	_read_reg(_id_regs[n].reg, r, _id_regs[n].words);
+	if (_id_regs[n].hi==_id_regs[n].lo)
+		return r[_id_regs[n].hi];
+	return ((r[_id_regs[n].hi] & 0xFF)<<8) | (r[_id_regs[n].lo] & 0xFF);
+}
+
+// Tries the ID registers of the usual controllers. Returns the first ID
+// that belongs to a linked driver, the ID of a known controller
+// without a driver here (ILI6804, NT35310, NT35510), or 0. reg is set to
+// the _id_regs entry that answered.
+uint16_t UTFT::_probe_id(byte *reg)
+{
+	uint16_t	r[2], id;
+
+	for (*reg=0; *reg<ID_REGS; (*reg)++)
+	{
+		id=_read_id(*reg);
+		if ((_init_by_id(id)) || (id==0x6804) || (id==0x5310))
+			return id;
+	}
+	_read_reg(0xDB00, r, 2);			// NT35510: 80 from DB00, 00 from DC00
+	id=(r[1] & 0xFF)<<8;
+	_read_reg(0xDC00, r, 2);
+	id|=r[1] & 0xFF;
+	if (id==0x8000)
+		return 0x5510;
+	return 0;
+}
+
+// Sum of an init table, so that a stored panel identity is dropped when
+// the firmware sends a different sequence
+static uint16_t _init_sum(const uint8_t *t)
+{
+	uint16_t	a=0, b=0;
+	byte		h;
+	int			n;
+
+	while ((h=pgm_read_byte(t))!=UTFT_INIT_END)
+	{
+		if (h==UTFT_INIT_DELAY)
+			n=2;
+		else if (h & UTFT_INIT_WORDS)
+			n=1+((h & UTFT_INIT_ARGS)+1)*2;
+		else
+			n=1+(h & UTFT_INIT_ARGS)+1;
+		for (; n>0; n--)
+		{
+			a=(a+pgm_read_byte(t++)) % 255;
+			b=(b+a) % 255;
+		}
+	}
+	return (b<<8) | a;
+}
+
+// Reads the controller ID. With a panel store that remembers the ID, the
+// register it came from and the sum of its init table, a single register
+// read confirms it; otherwise all ID registers are probed and the result
+// is stored for the next boot.
+uint16_t UTFT::_identify()
+{
+	uint8_t				rec[UTFT_PANEL_RECORD], old[UTFT_PANEL_RECORD];
+	const UTFT_Driver	*d;
+	uint16_t			id, sum;
+	byte				reg, i, chk;
+
+	if ((_store) && (_store->load(old, UTFT_PANEL_RECORD)))
+	{
+		for (i=0, chk=0; i<UTFT_PANEL_RECORD-1; i++)
+			chk+=old[i];
+		id=old[2] | (old[3]<<8);
+		d=_init_by_id(id);
+		if ((old[0]==UTFT_PANEL_MAGIC) && (old[UTFT_PANEL_RECORD-1]==(byte)~chk) && (d) && (old[1]<ID_REGS)
+		 && ((old[4] | (old[5]<<8))==_init_sum(d->table)) && (_read_id(old[1])==id))
+			return id;
+	}
+	else
+		memset(old, 0, UTFT_PANEL_RECORD);
+
+	id=_probe_id(&reg);
+	d=_init_by_id(id);
+	if ((_store) && (d))
+	{
+		sum=_init_sum(d->table);
+		rec[0]=UTFT_PANEL_MAGIC;
+		rec[1]=reg;
+		rec[2]=id;
+		rec[3]=id>>8;
+		rec[4]=sum;
+		rec[5]=sum>>8;
+		rec[6]=0;
+		for (i=0, chk=0; i<UTFT_PANEL_RECORD-1; i++)
+			chk+=rec[i];
+		rec[UTFT_PANEL_RECORD-1]=~chk;
+		if (memcmp(rec, old, UTFT_PANEL_RECORD)!=0)
+			_store->save(rec, UTFT_PANEL_RECORD);
+	}
+	return id;
+}
+
+static const uint16_t _bus_patterns[24] = {
+	0x0000, 0xFFFF, 0xAAAA, 0x5555, 0xFF00, 0x00FF, 0xF0F0, 0x0F0F,
+	0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+	0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000,
+};
+
+// Pixel i of test line pass: all 0, all 1, every data line toggling on each
+// write (both phases), the walking bits and their inverse, and a scramble
+static uint16_t _bus_pattern(byte pass, int i)
+{
+	switch (pass)
+	{
+	case 0:
+		return 0x0000;
+	case 1:
+		return 0xFFFF;
+	case 2:
+		return (i & 1) ? 0xFFFF : 0x0000;
+	case 3:
+		return (i & 1) ? 0x0000 : 0xFFFF;
+	case 4:
+		return _bus_patterns[i % 24];
+	case 5:
+		return ~_bus_patterns[i % 24];
+	default:
+		return (uint16_t)(((uint32_t)(i+1)*2654435761UL)>>13);
+	}
+}
+
+// Writes each test pattern over a line of w pixels at the top of the screen
+// and reads it back through the controller's GRAM read
+static bool _bus_check(UTFT *lcd, int w, uint16_t *out, uint16_t *back)
+{
+	byte	pass;
+	int		i;
+
+	for (pass=0; pass<UTFT_BUS_PASSES; pass++)
+	{
+		for (i=0; i<w; i++)
+			out[i]=_bus_pattern(pass, i);
+		cbi(lcd->P_CS, lcd->B_CS);
+		lcd->setXY(0, 0, w-1, 0);
+		lcd->_burst_16(out, w);
+		sbi(lcd->P_CS, lcd->B_CS);
+		memset(back, 0, w*sizeof(uint16_t));
+		lcd->readRect(0, 0, w, 1, back);
+		if (memcmp(out, back, w*sizeof(uint16_t))!=0)
+			return false;
+	}
+	return true;
+}
+
+// Finds the fastest bus timing profile whose writes read back unchanged and
+// keeps the next slower one as a margin. Returns the profile kept, or
+// UTFT_BUS_NONE (and keeps UTFT_BUS_DEFAULT) when that fails, e.g. on a
+// controller readRect() cannot read. Call after Init(); the pixels used for
+// the test are put back.
+byte UTFT::tuneBus()
+{
+	uint16_t	*saved;
+	int			w=disp_x_size+1;
+	byte		o=orient, p;
+
+	if (w>UTFT_BUS_LINE)
+		w=UTFT_BUS_LINE;
+	saved=(uint16_t *)malloc(3*w*sizeof(uint16_t));
+	if (!saved)
+		return UTFT_BUS_NONE;
+	orient=PORTRAIT;
+	readRect(0, 0, w, 1, saved);
+	for (p=0; p<UTFT_BUS_PROFILES; p++)
+	{
+		setBusProfile(p);
+		if (_bus_check(this, w, saved+w, saved+2*w))
+			break;
+	}
+	if (p<UTFT_BUS_PROFILES-1)
+	{
+		setBusProfile(++p);
+		if (!_bus_check(this, w, saved+w, saved+2*w))
+			p=UTFT_BUS_PROFILES;
+	}
+	if (p==UTFT_BUS_PROFILES)
+		setBusProfile(UTFT_BUS_DEFAULT);
+	cbi(P_CS, B_CS);
+	setXY(0, 0, w-1, 0);
+	_burst_16(saved, w);
+	sbi(P_CS, B_CS);
+	clrXY();
+	orient=o;
+	free(saved);
+	return (p==UTFT_BUS_PROFILES) ? UTFT_BUS_NONE : p;
+}
+
+byte UTFT::getBusProfile()
+{
+	return _bus_profile;
+}
+
+// Keeps the panel identity in store (e.g. a UTFT_PanelEEPROM) to skip the
+// ID probe on later boots. Set before Init().
+void UTFT::setPanelStore(UTFT_PanelStore *store)
+{
+	_store=store;
+}
+
 void UTFT::Init(byte orientation)
+{
+	initAsync(orientation);
+	while (!poll());
+}
+
+// Starts Init() and returns at the first wait. Call poll() until it returns
+// true before drawing anything; other hardware can be set up meanwhile.
+void UTFT::initAsync(byte orientation)
 {
 	orient=orientation;
 	_hw_special_init();
@@ -234,165 +575,88 @@ void UTFT::Init(byte orientation)
 
 	  _set_direction_registers(display_transfer_mode);
 
+	// the wait after reset is the one before the ID probe, see poll()
 	sbi(P_RST, B_RST);
-	delay(5); 
 	cbi(P_RST, B_RST);
-	delay(15);
+	USER_delay_us(UTFT_RST_LOW);
 	sbi(P_RST, B_RST);
-	delay(15);
 	//HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_SET);
 	cbi(P_CS, B_CS);
 	#endif
   #endif
-#if defined(STM32F107xC)
-	//stm setup
-	
-	#else
-  LCD_delay_ms(50); // delay 50 ms 
-  LCD_Write_COM_DATA(0x00,0x0001);
-  LCD_delay_ms(50); // delay 50 ms 
-  mode_id =  LCD_ReadData();  
-  if((mode_id < 0XFF)||(mode_id == 0XFFFF)||(mode_id ==0X9300)){ //teset 9341 6804 5310 5510
-    LCD_Write_COM(0xD3);      //test ili9341
-	mode_id = LCD_ReadData(); //dummy read 
-	mode_id = LCD_ReadData(); //read 0x00
-	mode_id = LCD_ReadData();   //0x93
-	mode_id <<=8;  
-	mode_id |=LCD_ReadData();  //0x41
-	if (mode_id !=0x9341){
-      LCD_Write_COM(0xBF);      //test ili9341
-	  mode_id = LCD_ReadData(); //dummy read 
-	  mode_id = LCD_ReadData(); //read 0x01
-	  mode_id = LCD_ReadData();   //0xD0
-	  mode_id = LCD_ReadData();   //0x68
-	  mode_id <<=8;  
-	  mode_id |=LCD_ReadData();  //0x41
-	  if (mode_id !=0X6804){
-        LCD_Write_COM(0xD4);      //NT35310
-	    mode_id = LCD_ReadData(); //dummy read 
-	    mode_id = LCD_ReadData(); //read 0x01
-		mode_id = LCD_ReadData();   //0x53
-		mode_id <<=8;  
-		mode_id |=LCD_ReadData();  //0x10
-	    if (mode_id !=0X5310){    //NT35510
-		  LCD_Write_COM(0xDA00); 
-	      mode_id = LCD_ReadData(); //dummy read 
-		  LCD_Write_COM(0xDB00); 
-	      mode_id = LCD_ReadData(); //read 0x80
-		  mode_id <<=8;  
-		  LCD_Write_COM(0xDC00); 
-		  mode_id |=LCD_ReadData();  //0x00
-		  if(mode_id ==0x8000){
-		    mode_id = 0x5510; // is NT35510
-	      } else{
-		    mode_id =0x00;
-		  }
-	    }
-	  }
-	}
-  }
-  #endif
- 
-  
- 
-	
-	delay(150);
-   
-	  
-  switch(display_model)
-  {
-#ifndef DISABLE_HX8347A
-	#include "tft_drivers/hx8347a/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9327
-	#include "tft_drivers/ili9327/initlcd.h"
-#endif
-#ifndef DISABLE_SSD1289
-	#include "tft_drivers/ssd1289/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9325C
-	#include "tft_drivers/ili9325c/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9325D
-	#include "tft_drivers/ili9325d/default/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9325D_ALT
-	#include "tft_drivers/ili9325d/alt/initlcd.h"
-#endif
-#ifndef DISABLE_HX8340B_8
-	#include "tft_drivers/hx8340b/8/initlcd.h"
-#endif
-#ifndef DISABLE_HX8340B_S
-	#include "tft_drivers/hx8340b/s/initlcd.h"
-#endif
-#ifndef DISABLE_ST7735
-	#include "tft_drivers/st7735/std/initlcd.h"
-#endif
-#ifndef DISABLE_ST7735_ALT
-	#include "tft_drivers/st7735/alt/initlcd.h"
-#endif
-#ifndef DISABLE_PCF8833
-	#include "tft_drivers/pcf8833/initlcd.h"
-#endif
-#ifndef DISABLE_S1D19122
-	#include "tft_drivers/s1d19122/initlcd.h"
-#endif
-#ifndef DISABLE_HX8352A
-	#include "tft_drivers/hx8352a/initlcd.h"
-#endif
-#ifndef DISABLE_SSD1963_480
-	#include "tft_drivers/ssd1963/480/initlcd.h"
-#endif
-#ifndef DISABLE_SSD1963_800
-	#include "tft_drivers/ssd1963/800/initlcd.h"
-#endif
-#ifndef DISABLE_SSD1963_800_ALT
-	#include "tft_drivers/ssd1963/800alt/initlcd.h"
-#endif
-#ifndef DISABLE_S6D1121
-	#include "tft_drivers/s6d1121/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9481
-	#include "tft_drivers/ili9481/initlcd.h"
-#endif
-#ifndef DISABLE_S6D0164
-	#include "tft_drivers/s6d0164/initlcd.h"
-#endif
-#ifndef DISABLE_ST7735S
-	#include "tft_drivers/st7735s/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9341_S4P
-	#include "tft_drivers/ili9341/s4p/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9341_S5P
-	#include "tft_drivers/ili9341/s5p/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9341_16
-	#include "tft_drivers/ili9341/initlcd.h"
-#endif
-#ifndef DISABLE_R61581
-	#include "tft_drivers/r61581/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9486
-	#include "tft_drivers/ili9486/initlcd.h"
-#endif
-#ifndef DISABLE_CPLD
-	#include "tft_drivers/cpld/initlcd.h"
-#endif
-#ifndef DISABLE_HX8353C
-	#include "tft_drivers/hx8353c/initlcd.h"
-#endif
-#ifndef DISABLE_ILI9320
-	#include "tft_drivers/ili9320/initlcd.h"
+	setColor(255, 255, 255);
+	setBackColor(0, 0, 0);
+	cfont.font=0;
+	cfont.source=0;
+	cfont.packed=0;
+	_transparent = false;
+
+	_init_start=millis();
+	_init_ms=0;
+	_init_due=_init_start+50;
+	_init_state=INIT_PROBE;
+}
+
+// Carries on with initAsync() when the current wait is over. Returns true
+// once the LCD is ready.
+bool UTFT::poll()
+{
+	const UTFT_Driver	*d;
+	uint16_t			ms=0;
+
+	if (_init_state==INIT_DONE)
+		return true;
+	if ((long)(millis()-_init_due)<0)
+		return false;
+
+	if (_init_state==INIT_PROBE)
+	{
+		if (display_transfer_mode!=1)
+			mode_id=_identify();
+		if (display_model==UTFT_AUTO)
+		{
+			d=_init_by_id(mode_id);
+			display_model=(d) ? d->model : UTFT_AUTO_FALLBACK;
+		}
+		d=_driver_by_model(display_model);
+#ifndef FSMC_TFT
+		if (d)
+		{
+			disp_x_size=d->xsize;
+			disp_y_size=d->ysize;
+		}
 #endif
+		_init_pos=(d) ? d->table : 0;
+		_setxy=(d) ? d->setxy : _setxy_none;
+		_init_due=millis()+150;
+		_init_state=INIT_TABLE;
+		return false;
+	}
+
+	if (_init_pos)
+		_init_pos=_init_step(_init_pos, &ms);
+	if (_init_pos)
+	{
+		_init_due=millis()+ms;
+		return false;
 	}
+
+	// what does not fit in a table
+	d=_driver_by_model(display_model);
+	if ((d) && (d->done))
+		d->done(this);
 	//HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_SET);
 	sbi (P_CS, B_CS); 
 
-	setColor(255, 255, 255);
-	setBackColor(0, 0, 0);
-	cfont.font=0;
-	_transparent = false;
+	_init_ms=millis()-_init_start;
+	_init_state=INIT_DONE;
+	return true;
+}
+
+// Time from initAsync() to a ready LCD in ms, 0 while it is not ready
+unsigned long UTFT::getInitTime()
+{
+	return _init_ms;
 }
 
 void UTFT::setXY(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
@@ -405,97 +669,30 @@ void UTFT::setXY(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 		y2=disp_y_size-y2;
 		swap(uint16_t, y1, y2)
 	}
+	if (_band)
+	{
+		_band->wx1=_band->cx=x1;
+		_band->wy1=_band->cy=y1;
+		_band->wx2=x2;
+		_band->wy2=y2;
+		return;
+	}
+	_set_window(x1, y1, x2, y2);
+}
 
-	switch(display_model)
+// Sets the GRAM window in controller coordinates. With tear sync on it is
+// remembered, so _tear_wait() can set it again, and the first large write
+// from its origin waits for the scan.
+void UTFT::_set_window(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	_setxy(this, x1, y1, x2, y2);
+	if (_tear)
 	{
-#ifndef DISABLE_HX8347A
-	#include "tft_drivers/hx8347a/setxy.h"
-#endif
-#ifndef DISABLE_HX8352A
-	#include "tft_drivers/hx8352a/setxy.h"
-	
-#endif
-#ifndef DISABLE_ILI9327
-	#include "tft_drivers/ili9327/setxy.h"
-#endif
-#ifndef DISABLE_SSD1289
-	#include "tft_drivers/ssd1289/setxy.h"
-#endif
-#ifndef DISABLE_ILI9325C
-	#include "tft_drivers/ili9325c/setxy.h"
-#endif
-#ifndef DISABLE_ILI9325D
-	#include "tft_drivers/ili9325d/default/setxy.h"
-#endif
-#ifndef DISABLE_ILI9325D_ALT
-	#include "tft_drivers/ili9325d/alt/setxy.h"
-#endif
-#ifndef DISABLE_HX8340B_8
-	#include "tft_drivers/hx8340b/8/setxy.h"
-#endif
-#ifndef DISABLE_HX8340B_S
-	#include "tft_drivers/hx8340b/s/setxy.h"
-#endif
-#ifndef DISABLE_ST7735
-	#include "tft_drivers/st7735/std/setxy.h"
-#endif
-#ifndef DISABLE_ST7735_ALT
-	#include "tft_drivers/st7735/alt/setxy.h"
-#endif
-#ifndef DISABLE_S1D19122
-	#include "tft_drivers/s1d19122/setxy.h"
-#endif
-#ifndef DISABLE_PCF8833
-	#include "tft_drivers/pcf8833/setxy.h"
-#endif
-#ifndef DISABLE_SSD1963_480
-	#include "tft_drivers/ssd1963/480/setxy.h"
-#endif
-#ifndef DISABLE_SSD1963_800
-	#include "tft_drivers/ssd1963/800/setxy.h"
-#endif
-#ifndef DISABLE_SSD1963_800_ALT
-	#include "tft_drivers/ssd1963/800alt/setxy.h"
-#endif
-#ifndef DISABLE_S6D1121
-	#include "tft_drivers/s6d1121/setxy.h"
-#endif
-#ifndef DISABLE_ILI9481
-	#include "tft_drivers/ili9481/setxy.h"
-#endif
-#ifndef DISABLE_S6D0164
-	#include "tft_drivers/s6d0164/setxy.h"
-#endif
-#ifndef DISABLE_ST7735S
-	#include "tft_drivers/st7735s/setxy.h"
-#endif
-#ifndef DISABLE_ILI9341_S4P
-	#include "tft_drivers/ili9341/s4p/setxy.h"
-#endif
-#ifndef DISABLE_ILI9341_S5P
-	#include "tft_drivers/ili9341/s5p/setxy.h"
-#endif
-#ifndef DISABLE_ILI9341_16
-	#include "tft_drivers/ili9341/setxy.h"
-#endif
-#ifndef DISABLE_R61581
-	#include "tft_drivers/r61581/setxy.h"
-#endif
-#ifndef DISABLE_ILI9486
-	#include "tft_drivers/ili9486/setxy.h"
-#endif
-#ifndef DISABLE_CPLD
-	#include "tft_drivers/cpld/setxy.h"
-#endif
-#ifndef DISABLE_HX8353C
-	#include "tft_drivers/hx8353c/setxy.h"
-#endif
-#ifndef DISABLE_ILI9320
-	#include "tft_drivers/ili9320/setxy.h"
-#endif
-#ifndef DISABLE_SPFD5420
-	#include "tft_drivers/SPFD5420/setxy.h"
-#endif
+		_tear_win[0]=x1;
+		_tear_win[1]=y1;
+		_tear_win[2]=x2;
+		_tear_win[3]=y2;
+		_tear_origin=true;
 	}
 }
 
@@ -987,6 +1184,12 @@ void UTFT::printChar(byte c, int x, int y)
 	byte i,ch;
 	uint16_t j;
 	uint16_t temp; 
+
+	if (cfont.packed)
+	{
+		printGlyph(_font_glyph(c), x, y);
+		return;
+	}
     
 	cbi(P_CS, B_CS);
   
@@ -997,22 +1200,7 @@ void UTFT::printChar(byte c, int x, int y)
 			setXY(x,y,x+cfont.x_size-1,y+cfont.y_size-1);
 	  
 			temp=((c-cfont.offset)*((cfont.x_size/8)*cfont.y_size))+4;
-			for(j=0;j<((cfont.x_size/8)*cfont.y_size);j++)
-			{
-				ch=pgm_read_byte(&cfont.font[temp]);
-				for(i=0;i<8;i++)
-				{   
-					if((ch&(1<<(7-i)))!=0)   
-					{
-						setPixel((fch<<8)|fcl);
-					} 
-					else
-					{
-						setPixel((bch<<8)|bcl);
-					}   
-				}
-				temp++;
-			}
+			_burst_bits(&cfont.font[temp], (cfont.x_size/8)*cfont.y_size, false);
 		}
 		else
 		{
@@ -1021,21 +1209,7 @@ void UTFT::printChar(byte c, int x, int y)
 			for(j=0;j<((cfont.x_size/8)*cfont.y_size);j+=(cfont.x_size/8))
 			{
 				setXY(x,y+(j/(cfont.x_size/8)),x+cfont.x_size-1,y+(j/(cfont.x_size/8)));
-				for (int zz=(cfont.x_size/8)-1; zz>=0; zz--)
-				{
-					ch=pgm_read_byte(&cfont.font[temp+zz]);
-					for(i=0;i<8;i++)
-					{   
-						if((ch&(1<<i))!=0)   
-						{
-							setPixel((fch<<8)|fcl);
-						} 
-						else
-						{
-							setPixel((bch<<8)|bcl);
-						}   
-					}
-				}
+				_burst_bits(&cfont.font[temp], cfont.x_size/8, true);
 				temp+=(cfont.x_size/8);
 			}
 		}
@@ -1066,200 +1240,517 @@ void UTFT::printChar(byte c, int x, int y)
 	clrXY();
 }
 
-void UTFT::rotateChar(byte c, int x, int y, int pos, int deg)
-{
-	byte i,j,ch;
-	uint16_t temp; 
-	int newx,newy;
-	double radian;
-	radian=deg*0.0175;  
-	
-	cbi(P_CS, B_CS);
-
-	temp=((c-cfont.offset)*((cfont.x_size/8)*cfont.y_size))+4;
-	for(j=0;j<cfont.y_size;j++) 
-	{
-		for (int zz=0; zz<(cfont.x_size/8); zz++)
-		{
-			ch=pgm_read_byte(&cfont.font[temp+zz]); 
-			for(i=0;i<8;i++)
-			{   
-				newx=x+(((i+(zz*8)+(pos*cfont.x_size))*cos(radian))-((j)*sin(radian)));
-				newy=y+(((j)*cos(radian))+((i+(zz*8)+(pos*cfont.x_size))*sin(radian)));
-
-				setXY(newx,newy,newx+1,newy+1);
-				
-				if((ch&(1<<(7-i)))!=0)   
-				{
-					setPixel((fch<<8)|fcl);
-				} 
-				else  
-				{
-					if (!_transparent)
-						setPixel((bch<<8)|bcl);
-				}   
-			}
-		}
-		temp+=(cfont.x_size/8);
-	}
-	//HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_SET);
-	sbi(P_CS, B_CS);
-	clrXY();
-}
-
 void UTFT::printStr(char *st, int x, int y, int deg)
 {
-	int stl, i;
-
-	stl = strlen(st);
+	const char	*p=st;
+	int			i;
 
-	if (orient==PORTRAIT)
+	if ((x==RIGHT) || (x==CENTER))
 	{
-	if (x==RIGHT)
-		x=(disp_x_size+1)-(stl*cfont.x_size);
-	if (x==CENTER)
-		x=((disp_x_size+1)-(stl*cfont.x_size))/2;
+		int w = getStrWidth(st);
+		int ds = (orient==PORTRAIT) ? disp_x_size+1 : disp_y_size+1;
+		x = (x==RIGHT) ? ds-w : (ds-w)/2;
 	}
-	else
+
+	if (cfont.packed)
 	{
-	if (x==RIGHT)
-		x=(disp_y_size+1)-(stl*cfont.x_size);
-	if (x==CENTER)
-		x=((disp_y_size+1)-(stl*cfont.x_size))/2;
+		int pen=0;
+
+		for (i=0; *p; i++)
+		{
+			if ((cfont.source) && ((i % UTFT_FONT_BATCH)==0))
+				_font_prefetch(p);
+			if (deg==0)
+				x += printGlyph(_font_glyph(utf8Next(&p)), x, y);
+			else
+				pen += _rotate_glyph(_font_glyph(utf8Next(&p)), x, y, pen, deg);
+		}
+		return;
 	}
 
-	for (i=0; i<stl; i++)
+	for (i=0; *p; i++)
 		if (deg==0)
-			printChar(*st++, x + (i*(cfont.x_size)), y);
+			printChar(_legacy_char(utf8Next(&p)), x + (i*(cfont.x_size)), y);
 		else
-			rotateChar(*st++, x, y, i, deg);
+			rotateChar(_legacy_char(utf8Next(&p)), x, y, i, deg);
 }
 
 void UTFT::printStr(const char *st, int x, int y, int deg){
 	 this->printStr((char *)st, x, y, deg);
 }
 
-void UTFT::printStr(String st, int x, int y, int deg)
+void UTFT::printStr(const String &st, int x, int y, int deg)
 {
-	char buf[st.length()+1];
-
-	st.toCharArray(buf, st.length()+1);
-	printStr(buf, x, y, deg);
-	
+	printStr(st.c_str(), x, y, deg);
 }
 
 void UTFT::printNumI(long num, int x, int y, int length, char filler)
 {
-	char buf[25];
-	char st[27];
-	boolean neg=false;
-	int c=0, f=0;
-  
-	if (num==0)
-	{
-		if (length!=0)
-		{
-			for (c=0; c<(length-1); c++)
-				st[c]=filler;
-			st[c]=48;
-			st[c+1]=0;
-		}
+	_print_fixed(num, 0, x, y, '.', length, filler, true, 0, true);
+}
+
+void UTFT::printNumF(double num, byte dec, int x, int y, char divider, int length, char filler)
+{
+	double	a=(num<0) ? -num : num;
+
+	if (dec<1)
+		dec=1;
+	else if (dec>5)
+		dec=5;
+
+	// one scale and round, the digits are then produced in integer math
+	while ((dec>0) && (a*_pow10[dec]>=2147483647.0))
+		dec--;
+	a=a*_pow10[dec]+0.5;
+	if (a>2147483647.0)
+		a=2147483647.0;
+	_print_fixed((num<0) ? -(int32_t)a : (int32_t)a, dec, x, y, divider, length, filler, true, 0);
+}
+
+void UTFT::printFixed(int32_t num, byte dec, int x, int y, char divider, int length, char filler)
+{
+	_print_fixed(num, dec, x, y, divider, length, filler, true, 0);
+}
+
+int UTFT::getFixedWidth(int32_t num, byte dec, int length)
+{
+	return _print_fixed(num, dec, 0, 0, '.', length, ' ', false, 0);
+}
+
+// Same formatting as printFixed into buf, which must hold max(length, 12)+1
+// bytes. Returns the string length.
+int UTFT::formatFixed(char *buf, int32_t num, byte dec, char divider, int length, char filler)
+{
+	int n=_print_fixed(num, dec, 0, 0, divider, length, filler, false, &buf);
+
+	*buf=0;
+	return n;
+}
+
+void UTFT::setFont(uint8_t* font)
+{
+	cfont.font=font;
+	cfont.source=0;
+	if ((fontbyte(0)==0) && (fontbyte(1)==UTFT_PFONT_MAGIC))
+		_set_packed_font();
+	else
+	{
+		cfont.packed=0;
+		cfont.x_size=fontbyte(0);
+		cfont.y_size=fontbyte(1);
+		cfont.offset=fontbyte(2);
+		cfont.numchars=fontbyte(3);
+	}
+}
+
+// Only packed fonts can be read through a font source.
+void UTFT::setFont(UTFT_FontSource* source)
+{
+	cfont.font=0;
+	cfont.source=source;
+	_set_packed_font();
+}
+
+void UTFT::_set_packed_font()
+{
+	uint8_t		h[UTFT_PFONT_HDR];
+
+	_font_read(0, h, UTFT_PFONT_HDR);
+	cfont.packed=1;
+	cfont.flags=h[2];
+	cfont.y_size=h[3];
+	cfont.ascent=h[4];
+	cfont.x_size=h[5];
+	cfont.nglyphs=h[6] | (h[7]<<8);
+	cfont.nranges=h[8] | (h[9]<<8);
+	cfont.fallback=h[10] | (h[11]<<8);
+	cfont.bitmaps=h[12] | (h[13]<<8) | ((uint32_t)h[14]<<16) | ((uint32_t)h[15]<<24);
+	cfont.offset=0;
+	cfont.numchars=0;
+}
+
+int UTFT::getStrWidth(const char *st)
+{
+	int w=0;
+
+	while (*st)
+		if (cfont.packed)
+			w += _glyph_advance(_font_glyph(utf8Next(&st)));
 		else
 		{
-			st[0]=48;
-			st[1]=0;
+			utf8Next(&st);
+			w += cfont.x_size;
 		}
+	return w;
+}
+
+int UTFT::getStrWidth(const String &st)
+{
+	return getStrWidth(st.c_str());
+}
+
+// Formats num/10^dec straight into the glyph renderer, most significant
+// digit first, without a string buffer or division. Space filler goes in
+// front of the sign, any other filler between the sign and the digits, as
+// printNumF() always did; with sign_first the sign leads either way, as
+// printNumI() always did.
+// Returns the width in pixels; nothing is drawn when draw is false. With out
+// set the characters are stored at *out instead and the count is returned.
+int UTFT::_print_fixed(int32_t num, byte dec, int x, int y, char divider, int length, char filler, bool draw, char **out, bool sign_first)
+{
+	uint32_t	v=(num<0) ? -(uint32_t)num : num;
+	uint32_t	rem;
+	int			ndig, fill, w, k;
+	char		c;
+
+	if (dec>9)
+		dec=9;
+	for (ndig=1; (ndig<10) && (v>=_pow10[ndig]); ndig++);
+	if (ndig<dec+1)
+		ndig=dec+1;
+	fill=length-ndig-(dec ? 1 : 0)-(num<0 ? 1 : 0);
+
+	if (draw && ((x==RIGHT) || (x==CENTER)))
+	{
+		int ds = (orient==PORTRAIT) ? disp_x_size+1 : disp_y_size+1;
+		w = _print_fixed(num, dec, 0, 0, divider, length, filler, false, 0, sign_first);
+		x = (x==RIGHT) ? ds-w : (ds-w)/2;
 	}
-	else
+	w=x;
+
+	if ((num<0) && ((filler!=' ') || (sign_first)))
+		x += _num_char('-', x, y, draw, out);
+	for (; fill>0; fill--)
+		x += _num_char(filler, x, y, draw, out);
+	if ((num<0) && (filler==' ') && (!sign_first))
+		x += _num_char('-', x, y, draw, out);
+	for (k=ndig-1; k>=0; k--)
 	{
-		if (num<0)
-		{
-			neg=true;
-			num=-num;
-		}
-	  
-		while (num>0)
-		{
-			buf[c]=48+(num % 10);
+		for (c='0', rem=_pow10[k]; v>=rem; v-=rem)
 			c++;
-			num=(num-(num % 10))/10;
-		}
-		buf[c]=0;
-	  
-		if (neg)
-		{
-			st[0]=45;
-		}
-	  
-		if (length>(c+neg))
-		{
-			for (int i=0; i<(length-c-neg); i++)
-			{
-				st[i+neg]=filler;
-				f++;
-			}
-		}
+		x += _num_char(c, x, y, draw, out);
+		if ((k==dec) && (dec))
+			x += _num_char(divider, x, y, draw, out);
+	}
+	return x-w;
+}
 
-		for (int i=0; i<c; i++)
-		{
-			st[i+neg+f]=buf[c-i-1];
-		}
-		st[c+neg+f]=0;
+int UTFT::_num_char(char c, int x, int y, bool draw, char **out)
+{
+	if (out)
+	{
+		*(*out)++=c;
+		return 1;
+	}
+	if (cfont.packed)
+	{
+		uint16_t glyph=_font_glyph((byte)c);
+		return draw ? printGlyph(glyph, x, y) : _glyph_advance(glyph);
+	}
+	if (draw)
+		printChar(_legacy_char((byte)c), x, y);
+	return cfont.x_size;
+}
+
+// Decodes the UTF-8 sequence at *st and advances past it. A byte that does
+// not start a valid, shortest form sequence is consumed on its own and
+// returned as UTFT_UTF8_RAW+byte, so the caller never stalls or runs past the
+// terminating zero and legacy 8-bit strings still get their byte values back.
+uint32_t UTFT::utf8Next(const char **st)
+{
+	const uint8_t	*s=(const uint8_t *)*st;
+	uint32_t		cp;
+	uint8_t			n, i;
 
+	if (s[0]<0x80)
+	{
+		*st+=1;
+		return s[0];
+	}
+	if ((s[0] & 0xE0)==0xC0)
+	{
+		n=1;
+		cp=s[0] & 0x1F;
+	}
+	else if ((s[0] & 0xF0)==0xE0)
+	{
+		n=2;
+		cp=s[0] & 0x0F;
+	}
+	else if ((s[0] & 0xF8)==0xF0)
+	{
+		n=3;
+		cp=s[0] & 0x07;
+	}
+	else
+		n=0;
+	for (i=1; (n) && (i<=n); i++)
+		if ((s[i] & 0xC0)==0x80)
+			cp=(cp<<6) | (s[i] & 0x3F);
+		else
+			n=0;
+	if ((n==0) || (cp<((n==1) ? 0x80 : (n==2) ? 0x800 : 0x10000)) || (cp>0x10FFFF) || ((cp & 0xFFFFF800)==0xD800))
+	{
+		*st+=1;
+		return UTFT_UTF8_RAW+s[0];
 	}
+	*st+=n+1;
+	return cp;
+}
 
-	printStr(st,x,y);
+// Maps a codepoint onto the character set of a fixed cell font. Undecodable
+// bytes keep their value so 8-bit fonts with extra glyphs above 0x7F still
+// work; anything else the font lacks is drawn as '?'.
+byte UTFT::_legacy_char(uint32_t cp)
+{
+	if ((cp>=UTFT_UTF8_RAW+0x80) && (cp<=UTFT_UTF8_RAW+0xFF))
+		cp-=UTFT_UTF8_RAW;
+	if ((cp>=cfont.offset) && (cp<(uint32_t)cfont.offset+cfont.numchars))
+		return cp;
+	if (('?'>=cfont.offset) && ('?'<cfont.offset+cfont.numchars))
+		return '?';
+	return cfont.offset;
 }
 
-void UTFT::printNumF(double num, byte dec, int x, int y, char divider, int length, char filler)
+uint8_t UTFT::_font_byte(uint32_t addr)
 {
-	char st[27];
-	boolean neg=false;
+	uint8_t		b;
 
-	if (dec<1)
-		dec=1;
-	else if (dec>5)
-		dec=5;
+	if (!cfont.source)
+		return pgm_read_byte(&cfont.font[addr]);
+	cfont.source->read(addr, &b, 1);
+	return b;
+}
+
+void UTFT::_font_read(uint32_t addr, uint8_t *buf, uint16_t len)
+{
+	if (cfont.source)
+		cfont.source->read(addr, buf, len);
+	else
+		while (len--)
+			*buf++ = pgm_read_byte(&cfont.font[addr++]);
+}
+
+// Hands the glyph descriptors and then the bitmaps of the next batch of
+// characters to the font source in one go, so it can fetch them with a few
+// sequential reads instead of one transaction per glyph.
+void UTFT::_font_prefetch(const char *st)
+{
+	uint32_t	addr[UTFT_FONT_BATCH];
+	uint16_t	len[UTFT_FONT_BATCH];
+	uint8_t		d[UTFT_PFONT_GLYPH];
+	uint32_t	glyphs=UTFT_PFONT_HDR+(uint32_t)cfont.nranges*UTFT_PFONT_RANGE;
+	int			i, n;
 
-	if (num<0)
-		neg = true;
+	for (n=0; (n<UTFT_FONT_BATCH) && (*st); n++)
+	{
+		addr[n]=glyphs+(uint32_t)_font_glyph(utf8Next(&st))*UTFT_PFONT_GLYPH;
+		len[n]=UTFT_PFONT_GLYPH;
+	}
+	cfont.source->prefetch(addr, len, n);
+	for (i=0; i<n; i++)
+	{
+		_font_read(addr[i], d, UTFT_PFONT_GLYPH);
+		addr[i]=cfont.bitmaps+(d[0] | (d[1]<<8) | ((uint32_t)d[2]<<16));
+		len[i]=((uint16_t)d[3]*d[4]+7)/8;	// exact for plain bitmaps, a fair guess for RLE
+	}
+	cfont.source->prefetch(addr, len, n);
+}
 
-	_convert_float(st, num, length, dec);
+// Binary search of the codepoint ranges, which fontconv emits in ascending
+// order. Unmapped codepoints get the font's fallback glyph.
+uint16_t UTFT::_font_glyph(uint32_t cp)
+{
+	uint8_t		r[UTFT_PFONT_RANGE];
+	uint32_t	first;
+	int			lo=0, hi=cfont.nranges-1, mid;
 
-	if (divider != '.')
+	while (lo<=hi)
 	{
-		for (unsigned int i=0; i<sizeof(st); i++)
-			if (st[i]=='.')
-				st[i]=divider;
+		mid=(lo+hi)/2;
+		_font_read(UTFT_PFONT_HDR+(uint32_t)mid*UTFT_PFONT_RANGE, r, UTFT_PFONT_RANGE);
+		first = r[0] | (r[1]<<8) | ((uint32_t)r[2]<<16) | ((uint32_t)r[3]<<24);
+		if (cp<first)
+			hi=mid-1;
+		else if (cp-first>=(uint32_t)(r[4] | (r[5]<<8)))
+			lo=mid+1;
+		else
+			return (r[6] | (r[7]<<8)) + (cp-first);
 	}
+	return cfont.fallback;
+}
+
+int UTFT::_glyph_advance(uint16_t glyph)
+{
+	return _font_byte(UTFT_PFONT_HDR+(uint32_t)cfont.nranges*UTFT_PFONT_RANGE+(uint32_t)glyph*UTFT_PFONT_GLYPH+5);
+}
 
-	if (filler != ' ')
+// Sequential pixel reader for packed glyph bitmaps, either plain bits (MSB
+// first) or nibble coded alternating background/foreground run lengths.
+struct _glyph_reader
+{
+	uint32_t	addr;
+	uint8_t		cur, left, run, colour, toggle, rle;
+};
+
+static byte _glyph_pixel(UTFT *t, _glyph_reader *gr)
+{
+	if (!gr->rle)
 	{
-		if (neg)
+		if (gr->left==0)
 		{
-			st[0]='-';
-			for (unsigned int i=1; i<sizeof(st); i++)
-				if ((st[i]==' ') || (st[i]=='-'))
-					st[i]=filler;
+			gr->cur=t->_font_byte(gr->addr++);
+			gr->left=8;
 		}
-		else
+		gr->left--;
+		return (gr->cur>>gr->left) & 1;
+	}
+	while (gr->run==0)
+	{
+		if (gr->toggle)
+			gr->colour^=1;
+		if (gr->left==0)
 		{
-			for (unsigned int i=0; i<sizeof(st); i++)
-				if (st[i]==' ')
-					st[i]=filler;
+			gr->cur=t->_font_byte(gr->addr++);
+			gr->left=2;
 		}
+		gr->left--;
+		gr->run=(gr->left ? gr->cur>>4 : gr->cur) & 0x0F;
+		gr->toggle=(gr->run!=15);
 	}
+	gr->run--;
+	return gr->colour;
+}
+
+// Samplers for drawRotated()
+struct _bits_image
+{
+	const uint8_t	*bits;
+	int				stride;
+};
+
+struct _bitmap_image
+{
+	bitmapdatatype	data;
+	int				sx;
+	uint32_t		key;
+};
+
+static uint32_t _cell_sample(UTFT *t, const void *src, int u, int v)
+{
+	byte ch=pgm_read_byte(&t->cfont.font[*(const uint32_t *)src+v*(t->cfont.x_size/8)+(u>>3)]);
 
-	printStr(st,x,y);
+	if (ch & (0x80>>(u&7)))
+		return (t->fch<<8) | t->fcl;
+	return (t->_transparent) ? UTFT_ROT_CLEAR : (t->bch<<8) | t->bcl;
 }
 
-void UTFT::setFont(uint8_t* font)
+static uint32_t _bits_sample(UTFT *t, const void *src, int u, int v)
 {
-	cfont.font=font;
-	cfont.x_size=fontbyte(0);
-	cfont.y_size=fontbyte(1);
-	cfont.offset=fontbyte(2);
-	cfont.numchars=fontbyte(3);
+	const _bits_image *bi=(const _bits_image *)src;
+
+	if (bi->bits[v*bi->stride+(u>>3)] & (0x80>>(u&7)))
+		return (t->fch<<8) | t->fcl;
+	return (t->_transparent) ? UTFT_ROT_CLEAR : (t->bch<<8) | t->bcl;
+}
+
+static uint32_t _bitmap_sample(UTFT *t, const void *src, int u, int v)
+{
+	const _bitmap_image *bm=(const _bitmap_image *)src;
+	uint32_t col=pgm_read_word(&bm->data[v*bm->sx+u]);
+
+	return (col==bm->key) ? UTFT_ROT_CLEAR : col;
+}
+
+void UTFT::rotateChar(byte c, int x, int y, int pos, int deg)
+{
+	uint32_t	addr=((c-cfont.offset)*((cfont.x_size/8)*cfont.y_size))+4;
+	int			pen=pos*cfont.x_size;
+
+	drawRotated(x+pen, y, cfont.x_size, cfont.y_size, -pen, 0, deg, _cell_sample, &addr);
+}
+
+// Rotates a packed glyph about (x,y), pen pixels along the baseline. The
+// glyph cell is decoded into a bit buffer first as RLE data can only be
+// read in order; cells larger than UTFT_ROT_GLYPH are skipped.
+int UTFT::_rotate_glyph(uint16_t glyph, int x, int y, int pen, int deg)
+{
+	uint8_t			d[UTFT_PFONT_GLYPH];
+	uint8_t			bits[UTFT_ROT_GLYPH];
+	_glyph_reader	gr;
+	_bits_image		bi;
+	int				w, h, adv, xo, yo, r, c;
+
+	_font_read(UTFT_PFONT_HDR+(uint32_t)cfont.nranges*UTFT_PFONT_RANGE+(uint32_t)glyph*UTFT_PFONT_GLYPH, d, UTFT_PFONT_GLYPH);
+	w=d[3]; h=d[4]; adv=d[5]; xo=d[6]; yo=d[7];
+	bi.stride=(adv+7)/8;
+	if (bi.stride*cfont.y_size>UTFT_ROT_GLYPH)
+		return adv;
+	gr.addr=cfont.bitmaps+(d[0] | (d[1]<<8) | ((uint32_t)d[2]<<16));
+	gr.left=gr.run=gr.colour=gr.toggle=0;
+	gr.rle=cfont.flags & UTFT_PFONT_RLE;
+
+	// a damaged glyph can claim more than its cell; the rest is dropped
+	memset(bits, 0, bi.stride*cfont.y_size);
+	for (r=yo; (r<yo+h) && (r<cfont.y_size); r++)
+		for (c=xo; c<xo+w; c++)
+			if ((_glyph_pixel(this, &gr)) && (c<adv))
+				bits[r*bi.stride+(c>>3)] |= 0x80>>(c&7);
+	bi.bits=bits;
+	drawRotated(x+pen, y, adv, cfont.y_size, -pen, 0, deg, _bits_sample, &bi);
+	return adv;
+}
+
+int UTFT::printGlyph(uint16_t glyph, int x, int y)
+{
+	uint8_t			d[UTFT_PFONT_GLYPH];
+	uint8_t			row[32];
+	_glyph_reader	gr;
+	int				w, h, adv, xo, yo, r, c, c0;
+
+	_font_read(UTFT_PFONT_HDR+(uint32_t)cfont.nranges*UTFT_PFONT_RANGE+(uint32_t)glyph*UTFT_PFONT_GLYPH, d, UTFT_PFONT_GLYPH);
+	w=d[3]; h=d[4]; adv=d[5]; xo=d[6]; yo=d[7];
+	gr.addr=cfont.bitmaps+(d[0] | (d[1]<<8) | ((uint32_t)d[2]<<16));
+	gr.left=gr.run=gr.colour=gr.toggle=0;
+	gr.rle=cfont.flags & UTFT_PFONT_RLE;
+
+	cbi(P_CS, B_CS);
+	if ((!_transparent) && (orient==PORTRAIT))
+		setXY(x, y, x+adv-1, y+cfont.y_size-1);
+	for (r=0; r<cfont.y_size; r++)
+	{
+		memset(row, 0, (adv+7)/8);
+		if ((r>=yo) && (r<yo+h))
+			for (c=xo; c<xo+w; c++)
+				if ((_glyph_pixel(this, &gr)) && (c<adv))	// a damaged glyph must not run past row[]
+					row[c>>3] |= 0x80>>(c&7);
+
+		if (_transparent)
+		{
+			for (c=0; c<adv; c++)
+				if (row[c>>3] & (0x80>>(c&7)))
+				{
+					for (c0=c; (c+1<adv) && (row[(c+1)>>3] & (0x80>>((c+1)&7))); c++);
+					setXY(x+c0, y+r, x+c, y+r);
+					for (int i=c0; i<=c; i++)
+						setPixel((fch<<8)|fcl);
+				}
+		}
+		else if (orient==PORTRAIT)
+		{
+			for (c=0; c<adv; c++)
+				setPixel((row[c>>3] & (0x80>>(c&7))) ? (fch<<8)|fcl : (bch<<8)|bcl);
+		}
+		else
+		{
+			setXY(x, y+r, x+adv-1, y+r);
+			for (c=adv-1; c>=0; c--)
+				setPixel((row[c>>3] & (0x80>>(c&7))) ? (fch<<8)|fcl : (bch<<8)|bcl);
+		}
+	}
+	sbi(P_CS, B_CS);
+	clrXY();
+	return adv;
 }
 
 uint8_t* UTFT::getFont()
@@ -1280,101 +1771,549 @@ uint8_t UTFT::getFontYsize()
 void UTFT::drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int scale)
 {
 	unsigned int col;
-	int tx, ty, tc, tsx, tsy;
+	int tx, ty;
 
-	if (scale==1)
+	if (scale!=1)
+		drawBitmapScaled(x, y, sx, sy, data, sx*scale, sy*scale);
+	else if (orient==PORTRAIT)
 	{
-		if (orient==PORTRAIT)
+		cbi(P_CS, B_CS);
+		setXY(x, y, x+sx-1, y+sy-1);
+		_burst_16(data, (long)sx*sy);
+		sbi(P_CS, B_CS);
+		clrXY();
+	}
+	else
+	{
+		cbi(P_CS, B_CS);
+		for (ty=0; ty<sy; ty++)
 		{
-			cbi(P_CS, B_CS);
-			setXY(x, y, x+sx-1, y+sy-1);
-			for (tc=0; tc<(sx*sy); tc++)
+			setXY(x, y+ty, x+sx-1, y+ty);
+			for (tx=sx-1; tx>=0; tx--)
 			{
-				col=pgm_read_word(&data[tc]);
+				col=pgm_read_word(&data[(ty*sx)+tx]);
 				LCD_Write_DATA(col>>8,col & 0xff);
 			}
-			sbi(P_CS, B_CS);
 		}
-		else
+		sbi(P_CS, B_CS);
+		clrXY();
+	}
+}
+
+// Scales an sx*sy bitmap to dw*dh. Every source row is expanded once into a
+// RAM line buffer, which is then sent for all the output rows it covers.
+// Nearest neighbour handles any size; UTFT_SCALE_EPX smooths exact 2x.
+void UTFT::drawBitmapScaled(int x, int y, int sx, int sy, bitmapdatatype data, int dw, int dh, byte mode)
+{
+	uint16_t	line[UTFT_SCALE_LINE];
+	uint32_t	fx, fy, u;
+	int			tx, ty, cx, cw, row, rows, vw;
+
+	if ((dw<=0) || (dh<=0))
+		return;
+	if ((mode==UTFT_SCALE_EPX) && (dw==sx*2) && (dh==sy*2) && (dw<=UTFT_SCALE_LINE))
+	{
+		_scale_epx(x, y, sx, sy, data);
+		return;
+	}
+
+	// the step comes from the requested size; what lies past the right edge
+	// is clipped, and wide rows go out UTFT_SCALE_LINE pixels at a time
+	fx=((uint32_t)sx<<16)/dw;
+	fy=((uint32_t)sy<<16)/dh;
+	vw=((orient==PORTRAIT) ? disp_x_size+1 : disp_y_size+1)-x;
+	if (vw>dw)
+		vw=dw;
+	if (vw<=0)
+		return;
+	cbi(P_CS, B_CS);
+	for (ty=0; ty<dh; ty+=rows)
+	{
+		row=(ty*fy+fy/2)>>16;
+		for (rows=1; (ty+rows<dh) && ((int)(((ty+rows)*fy+fy/2)>>16)==row); rows++);
+		for (cx=0; cx<vw; cx+=cw)
 		{
-			cbi(P_CS, B_CS);
-			for (ty=0; ty<sy; ty++)
-			{
-				setXY(x, y+ty, x+sx-1, y+ty);
-				for (tx=sx-1; tx>=0; tx--)
-				{
-					col=pgm_read_word(&data[(ty*sx)+tx]);
-					LCD_Write_DATA(col>>8,col & 0xff);
-				}
-			}
-			sbi(P_CS, B_CS);
+			cw=(vw-cx<UTFT_SCALE_LINE) ? vw-cx : UTFT_SCALE_LINE;
+			for (tx=0, u=cx*fx+fx/2; tx<cw; tx++, u+=fx)
+				line[(orient==PORTRAIT) ? tx : cw-1-tx]=pgm_read_word(&data[row*sx+(u>>16)]);
+			_push_rows(x+cx, y+ty, cw, rows, line);
 		}
 	}
+	sbi(P_CS, B_CS);
+	clrXY();
+}
+
+// Sends the same line to rows consecutive rows. In portrait that is a single
+// window; in landscape a multi row window runs across the rows, so each row
+// gets its own.
+void UTFT::_push_rows(int x, int y, int w, int rows, const uint16_t *line)
+{
+	int r;
+
+	if (orient==PORTRAIT)
+	{
+		setXY(x, y, x+w-1, y+rows-1);
+		for (r=0; r<rows; r++)
+			_burst_16(line, w);
+	}
 	else
+		for (r=0; r<rows; r++)
+		{
+			setXY(x, y+r, x+w-1, y+r);
+			_burst_16(line, w);
+		}
+}
+
+// EPX / Scale2x: each source pixel becomes 2x2, corners take the colour of
+// two matching neighbours so diagonal edges stay smooth.
+void UTFT::_scale_epx(int x, int y, int sx, int sy, bitmapdatatype data)
+{
+	uint16_t	top[UTFT_SCALE_LINE], bot[UTFT_SCALE_LINE];
+	uint16_t	p, a, b, c, d;
+	int			tx, ty, i, j, dw=sx*2;
+
+	cbi(P_CS, B_CS);
+	for (ty=0; ty<sy; ty++)
 	{
+		for (tx=0; tx<sx; tx++)
+		{
+			p=pgm_read_word(&data[ty*sx+tx]);
+			a=(ty>0) ? pgm_read_word(&data[(ty-1)*sx+tx]) : p;
+			b=(tx<sx-1) ? pgm_read_word(&data[ty*sx+tx+1]) : p;
+			c=(tx>0) ? pgm_read_word(&data[ty*sx+tx-1]) : p;
+			d=(ty<sy-1) ? pgm_read_word(&data[(ty+1)*sx+tx]) : p;
+			i=(orient==PORTRAIT) ? tx*2 : dw-1-tx*2;		// left and right output pixel
+			j=(orient==PORTRAIT) ? i+1 : i-1;
+			top[i]=((c==a) && (c!=d) && (a!=b)) ? a : p;
+			top[j]=((a==b) && (a!=c) && (b!=d)) ? b : p;
+			bot[i]=((d==c) && (d!=b) && (c!=a)) ? c : p;
+			bot[j]=((b==d) && (b!=a) && (d!=c)) ? d : p;
+		}
 		if (orient==PORTRAIT)
 		{
-			cbi(P_CS, B_CS);
-			for (ty=0; ty<sy; ty++)
-			{
-				setXY(x, y+(ty*scale), x+((sx*scale)-1), y+(ty*scale)+scale);
-				for (tsy=0; tsy<scale; tsy++)
-					for (tx=0; tx<sx; tx++)
-					{
-						col=pgm_read_word(&data[(ty*sx)+tx]);
-						for (tsx=0; tsx<scale; tsx++)
-							LCD_Write_DATA(col>>8,col & 0xff);
-					}
-			}
-			sbi(P_CS, B_CS);
+			setXY(x, y+ty*2, x+dw-1, y+ty*2+1);
+			_burst_16(top, dw);
+			_burst_16(bot, dw);
 		}
 		else
 		{
-			cbi(P_CS, B_CS);
-			for (ty=0; ty<sy; ty++)
+			_push_rows(x, y+ty*2, dw, 1, top);
+			_push_rows(x, y+ty*2+1, dw, 1, bot);
+		}
+	}
+	sbi(P_CS, B_CS);
+	clrXY();
+}
+
+void UTFT::drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int deg, int rox, int roy, uint32_t key)
+{
+	_bitmap_image	bm;
+
+	if ((deg==0) && (key==VGA_TRANSPARENT))
+		drawBitmap(x, y, sx, sy, data);
+	else
+	{
+		bm.data=data;
+		bm.sx=sx;
+		bm.key=key;
+		drawRotated(x, y, sx, sy, rox, roy, deg, _bitmap_sample, &bm);
+	}
+}
+
+void UTFT::drawImage(int x, int y, const uint8_t *img)
+{
+	switch (pgm_read_byte(&img[0]))
+	{
+	case UTFT_IMG_INDEXED:
+		_draw_indexed(x, y, img);
+		break;
+	case UTFT_IMG_RLE:
+		_draw_rle(x, y, img);
+		break;
+	}
+}
+
+// Decodes straight to the bus: runs go to the constant colour fill, literal
+// runs are burst from the image data. In portrait the whole image is one
+// window; in landscape rows run right to left, so every piece of a row gets
+// its own window and literals are sent from their last pixel back.
+void UTFT::_draw_rle(int x, int y, const uint8_t *img)
+{
+	int				w=pgm_read_byte(&img[2]) | (pgm_read_byte(&img[3])<<8);
+	int				h=pgm_read_byte(&img[4]) | (pgm_read_byte(&img[5])<<8);
+	const uint8_t	*p=img+UTFT_IMG_HDR;
+	long			left=(long)w*h, n;
+	int				tx=0, ty=0, k;
+	uint16_t		code;
+
+	cbi(P_CS, B_CS);
+	if (orient==PORTRAIT)
+		setXY(x, y, x+w-1, y+h-1);
+	while (left>0)
+	{
+		code=pgm_read_byte(&p[0]) | (pgm_read_byte(&p[1])<<8);
+		p+=2;
+		n=(code & 0x7FFF)+1;
+		if (n>left)
+			n=left;
+		left-=n;
+		if (orient==PORTRAIT)
+		{
+			if (code & 0x8000)
+				_fast_fill_16(pgm_read_byte(&p[1]), pgm_read_byte(&p[0]), n);
+			else
+				_burst_le(p, n, false);
+		}
+		else
+			for (const uint8_t *q=p; n>0; n-=k)
 			{
-				for (tsy=0; tsy<scale; tsy++)
+				k=(n<w-tx) ? n : w-tx;
+				setXY(x+tx, y+ty, x+tx+k-1, y+ty);
+				if (code & 0x8000)
+					_fast_fill_16(pgm_read_byte(&q[1]), pgm_read_byte(&q[0]), k);
+				else
 				{
-					setXY(x, y+(ty*scale)+tsy, x+((sx*scale)-1), y+(ty*scale)+tsy);
-					for (tx=sx-1; tx>=0; tx--)
-					{
-						col=pgm_read_word(&data[(ty*sx)+tx]);
-						for (tsx=0; tsx<scale; tsx++)
-							LCD_Write_DATA(col>>8,col & 0xff);
-					}
+					_burst_le(q, k, true);
+					q+=k*2;
+				}
+				tx+=k;
+				if (tx==w)
+				{
+					tx=0;
+					ty++;
 				}
 			}
-			sbi(P_CS, B_CS);
-		}
+		p+=(code & 0x8000) ? 2 : ((code & 0x7FFF)+1)*2;
 	}
+	sbi(P_CS, B_CS);
 	clrXY();
 }
 
-void UTFT::drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int deg, int rox, int roy)
+// Output of UTFT_JPEG: one MCU, sent as one window. Landscape windows fill
+// column by column from the right, so the block is reordered on the way;
+// so is the visible part of a block that is clipped by the screen edge.
+void UTFT::_jpeg_block(void *io, int x, int y, int w, int h, const uint16_t *pix)
 {
-	unsigned int col;
-	int tx, ty, newx, newy;
-	double radian;
-	radian=deg*0.0175;  
+	_jpeg_target	*t=(_jpeg_target *)io;
+	UTFT			*lcd=t->lcd;
+	uint16_t		buf[256], *o=buf;
+	int				dispx=(lcd->orient==PORTRAIT) ? lcd->disp_x_size : lcd->disp_y_size;
+	int				dispy=(lcd->orient==PORTRAIT) ? lcd->disp_y_size : lcd->disp_x_size;
+	int				x1=0, y1=0, x2=w-1, y2=h-1, i, j;
+
+	x+=t->x;
+	y+=t->y;
+	if (x<0)
+		x1=-x;
+	if (y<0)
+		y1=-y;
+	if (x+x2>dispx)
+		x2=dispx-x;
+	if (y+y2>dispy)
+		y2=dispy-y;
+	if ((x1>x2) || (y1>y2))
+		return;
 
-	if (deg==0)
-		drawBitmap(x, y, sx, sy, data);
+	lcd->setXY(x+x1, y+y1, x+x2, y+y2);
+	if (lcd->orient==PORTRAIT)
+	{
+		if ((x1==0) && (y1==0) && (x2==w-1) && (y2==h-1))
+		{
+			lcd->_burst_16(pix, w*h);
+			return;
+		}
+		for (j=y1; j<=y2; j++)
+			for (i=x1; i<=x2; i++)
+				*o++=pix[j*w+i];
+	}
 	else
+		for (i=x2; i>=x1; i--)
+			for (j=y1; j<=y2; j++)
+				*o++=pix[j*w+i];
+	lcd->_burst_16(buf, o-buf);
+}
+
+struct _jpeg_mem
+{
+	_jpeg_target	t;
+	const uint8_t	*data;
+	uint32_t		len;
+};
+
+static int _jpeg_mem_read(void *io, uint8_t *buf, int len)
+{
+	_jpeg_mem	*m=(_jpeg_mem *)io;
+	int			i;
+
+	if ((uint32_t)len>m->len)
+		len=m->len;
+	for (i=0; i<len; i++)
+		buf[i]=pgm_read_byte(&m->data[i]);
+	m->data+=len;
+	m->len-=len;
+	return len;
+}
+
+// Draws a baseline JPEG held in memory at 1/1, 1/2, 1/4 or 1/8 size
+// (UTFT_JPEG_FULL..UTFT_JPEG_EIGHTH). The decoder is only allocated while
+// the image is drawn.
+int UTFT::drawJPEG(int x, int y, const uint8_t *data, uint32_t len, byte scale)
+{
+	_jpeg_mem	m;
+
+	m.t.lcd=this;
+	m.t.x=x;
+	m.t.y=y;
+	m.data=data;
+	m.len=len;
+	return _draw_jpeg(_jpeg_mem_read, &m.t, scale);
+}
+
+int UTFT::_draw_jpeg(UTFT_JPEG_Read read, _jpeg_target *io, byte scale)
+{
+	UTFT_JPEG	*jpg=(UTFT_JPEG *)malloc(sizeof(UTFT_JPEG));
+	int			res;
+
+	if (!jpg)
+		return UTFT_FILE_MEMORY;
+	res=jpg->begin(read, io);
+	if (res==UTFT_JPEG_OK)
 	{
 		cbi(P_CS, B_CS);
-		for (ty=0; ty<sy; ty++)
-			for (tx=0; tx<sx; tx++)
+		res=jpg->decode(_jpeg_block, scale);
+		sbi(P_CS, B_CS);
+		clrXY();
+	}
+	free(jpg);
+	return res;
+}
+
+static inline byte _index_at(const uint8_t *row, byte bpp, int i)
+{
+	return ((pgm_read_byte(&row[(i*bpp)>>3])<<((i*bpp)&7)) & 0xFF)>>(8-bpp);
+}
+
+// Expands n palette indices starting at pixel first of a row into colours,
+// stored every step entries from out. Whole bytes are unrolled per depth;
+// pixels that share a byte with the ones before first are taken one by one.
+static void _expand_indexed(const uint8_t *row, byte bpp, const uint16_t *pal, int first, int n, uint16_t *out, int step)
+{
+	const uint8_t	*p;
+	uint8_t			b;
+
+	for (; (n>0) && ((first*bpp) & 7); first++, n--, out+=step)
+		*out=pal[_index_at(row, bpp, first)];
+	p=row+((first*bpp)>>3);
+
+	switch (bpp)
+	{
+	case 8:
+		for (; n>0; n--, out+=step)
+			*out=pal[pgm_read_byte(p++)];
+		break;
+	case 4:
+		for (; n>=2; n-=2)
+		{
+			b=pgm_read_byte(p++);
+			*out=pal[b>>4];			out+=step;
+			*out=pal[b & 0x0F];		out+=step;
+		}
+		if (n)
+			*out=pal[pgm_read_byte(p)>>4];
+		break;
+	case 2:
+		for (; n>=4; n-=4)
+		{
+			b=pgm_read_byte(p++);
+			*out=pal[b>>6];			out+=step;
+			*out=pal[(b>>4) & 3];	out+=step;
+			*out=pal[(b>>2) & 3];	out+=step;
+			*out=pal[b & 3];		out+=step;
+		}
+		for (b=pgm_read_byte(p); n>0; n--, b<<=2, out+=step)
+			*out=pal[b>>6];
+		break;
+	case 1:
+		for (; n>=8; n-=8)
+		{
+			b=pgm_read_byte(p++);
+			*out=pal[b>>7];			out+=step;
+			*out=pal[(b>>6) & 1];	out+=step;
+			*out=pal[(b>>5) & 1];	out+=step;
+			*out=pal[(b>>4) & 1];	out+=step;
+			*out=pal[(b>>3) & 1];	out+=step;
+			*out=pal[(b>>2) & 1];	out+=step;
+			*out=pal[(b>>1) & 1];	out+=step;
+			*out=pal[b & 1];		out+=step;
+		}
+		for (b=pgm_read_byte(p); n>0; n--, b<<=1, out+=step)
+			*out=pal[b>>7];
+		break;
+	}
+}
+
+// Rows are expanded through a RAM copy of the palette into the line buffer
+// and sent as bursts, in chunks of UTFT_SCALE_LINE pixels for wide images.
+// Transparent images go out as spans between the transparent pixels.
+void UTFT::_draw_indexed(int x, int y, const uint8_t *img)
+{
+	uint16_t		pal[256];
+	uint16_t		line[UTFT_SCALE_LINE];
+	byte			bpp=pgm_read_byte(&img[1]);
+	int				w=pgm_read_byte(&img[2]) | (pgm_read_byte(&img[3])<<8);
+	int				h=pgm_read_byte(&img[4]) | (pgm_read_byte(&img[5])<<8);
+	int				ncol=pgm_read_byte(&img[6])+1;
+	byte			flags=pgm_read_byte(&img[7]);
+	const uint8_t	*row=img+UTFT_IMG_HDR+ncol*2;
+	int				stride=(w*bpp+7)/8;
+	int				ty, tx, n, i;
+
+	if ((bpp!=1) && (bpp!=2) && (bpp!=4) && (bpp!=8))
+		return;
+	for (i=0; i<ncol; i++)
+		pal[i]=pgm_read_byte(&img[UTFT_IMG_HDR+i*2]) | (pgm_read_byte(&img[UTFT_IMG_HDR+i*2+1])<<8);
+
+	cbi(P_CS, B_CS);
+	if ((!(flags & UTFT_IMG_TRANSPARENT)) && (orient==PORTRAIT))
+		setXY(x, y, x+w-1, y+h-1);
+	for (ty=0; ty<h; ty++, row+=stride)
+	{
+		if (flags & UTFT_IMG_TRANSPARENT)
+		{
+			for (tx=0; tx<w; tx=i)
 			{
-				col=pgm_read_word(&data[(ty*sx)+tx]);
+				for (; (tx<w) && (_index_at(row, bpp, tx)==0); tx++);
+				for (i=tx; (i<w) && (i-tx<UTFT_SCALE_LINE) && (_index_at(row, bpp, i)!=0); i++);
+				if (i>tx)
+				{
+					n=i-tx;
+					if (orient==PORTRAIT)
+						_expand_indexed(row, bpp, pal, tx, n, line, 1);
+					else
+						_expand_indexed(row, bpp, pal, tx, n, line+n-1, -1);
+					setXY(x+tx, y+ty, x+i-1, y+ty);
+					_burst_16(line, n);
+				}
+			}
+		}
+		else if (orient==PORTRAIT)
+			for (tx=0; tx<w; tx+=n)
+			{
+				n=(w-tx<UTFT_SCALE_LINE) ? w-tx : UTFT_SCALE_LINE;
+				_expand_indexed(row, bpp, pal, tx, n, line, 1);
+				_burst_16(line, n);
+			}
+		else
+			for (tx=w; tx>0; tx-=n)
+			{
+				n=(tx<UTFT_SCALE_LINE) ? tx : UTFT_SCALE_LINE;
+				_expand_indexed(row, bpp, pal, tx-n, n, line+n-1, -1);
+				setXY(x+tx-n, y+ty, x+tx-1, y+ty);
+				_burst_16(line, n);
+			}
+	}
+	sbi(P_CS, B_CS);
+	clrXY();
+}
 
-				newx=x+rox+(((tx-rox)*cos(radian))-((ty-roy)*sin(radian)));
-				newy=y+roy+(((ty-roy)*cos(radian))+((tx-rox)*sin(radian)));
+// sin(0..90 degrees) in Q15, 32768 is 1.0 so right angles come out exact
+static const uint16_t _sin_q15[91]={
+	0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126,
+	5690, 6252, 6813, 7371, 7927, 8481, 9032, 9580, 10126, 10668,
+	11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+	16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+	21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+	25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+	28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+	30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+	32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+	32768
+};
+
+static int32_t _sin_deg(int deg)
+{
+	deg%=360;
+	if (deg<0)
+		deg+=360;
+	if (deg<=90)
+		return _sin_q15[deg];
+	if (deg<=180)
+		return _sin_q15[180-deg];
+	if (deg<=270)
+		return -_sin_q15[deg-180];
+	return -_sin_q15[360-deg];
+}
 
-				setXY(newx, newy, newx, newy);
-				LCD_Write_DATA(col>>8,col & 0xff);
+// Draws an sx*sy source image rotated by deg about (x+rox, y+roy), placed
+// like the unrotated image at (x,y). Works backwards from the screen: every
+// destination scanline of the bounding box is walked with a Q15 source
+// position, so the output has no holes and costs no floating point. Pixels
+// the sampler returns as UTFT_ROT_CLEAR are skipped and the rest goes out as
+// spans of up to UTFT_ROT_SPAN pixels per window.
+void UTFT::drawRotated(int x, int y, int sx, int sy, int rox, int roy, int deg, UTFT_Sampler sample, const void *src)
+{
+	int32_t		s=_sin_deg(deg), c=_sin_deg(deg+90);
+	int32_t		u, v, du, dv;
+	int			px=x+rox, py=y+roy;
+	int			x1=0x7FFF, y1=0x7FFF, x2=-0x7FFF, y2=-0x7FFF;
+	int			dispx=(orient==PORTRAIT) ? disp_x_size : disp_y_size;
+	int			dispy=(orient==PORTRAIT) ? disp_y_size : disp_x_size;
+	int			tx, ty, i, n, xs;
+	uint16_t	span[UTFT_ROT_SPAN];
+	uint32_t	col;
+
+	for (i=0; i<4; i++)
+	{
+		du=((i & 1) ? sx : 0)-rox;
+		dv=((i & 2) ? sy : 0)-roy;
+		tx=px+((du*c-dv*s)>>15);
+		ty=py+((du*s+dv*c)>>15);
+		if (tx<x1) x1=tx;
+		if (tx>x2) x2=tx;
+		if (ty<y1) y1=ty;
+		if (ty>y2) y2=ty;
+	}
+	x1--; y1--; x2++; y2++;
+	if (x1<0) x1=0;
+	if (y1<0) y1=0;
+	if (x2>dispx) x2=dispx;
+	if (y2>dispy) y2=dispy;
+
+	cbi(P_CS, B_CS);
+	for (ty=y1; ty<=y2; ty++)
+	{
+		u=(rox<<15)+(x1-px)*c+(ty-py)*s+0x4000;
+		v=(roy<<15)-(x1-px)*s+(ty-py)*c+0x4000;
+		n=0;
+		xs=x1;
+		for (tx=x1; tx<=x2+1; tx++, u+=c, v-=s)
+		{
+			du=u>>15;
+			dv=v>>15;
+			if ((tx<=x2) && (du>=0) && (du<sx) && (dv>=0) && (dv<sy))
+				col=sample(this, src, du, dv);
+			else
+				col=UTFT_ROT_CLEAR;
+			if ((n) && ((col==UTFT_ROT_CLEAR) || (n==UTFT_ROT_SPAN)))
+			{
+				setXY(xs, ty, xs+n-1, ty);
+				if (orient==PORTRAIT)
+					for (i=0; i<n; i++)
+						LCD_Write_DATA(span[i]>>8, span[i] & 0xFF);
+				else
+					for (i=n-1; i>=0; i--)
+						LCD_Write_DATA(span[i]>>8, span[i] & 0xFF);
+				n=0;
 			}
-		sbi(P_CS, B_CS);
+			if (col!=UTFT_ROT_CLEAR)
+			{
+				if (n==0)
+					xs=tx;
+				span[n++]=col;
+			}
+		}
 	}
+	sbi(P_CS, B_CS);
 	clrXY();
 }
 
@@ -1466,6 +2405,117 @@ int UTFT::h_read_DATA(void)
 	return LCD_ReadData();
 }
 
+// Reads w x h pixels of GRAM at (x,y) into out, rows packed; pixels off the
+// screen are left as they are. The bus is turned round once for the whole
+// rectangle and read in batches of UTFT_READ_BATCH words, which come in the
+// order a window is written. ILI932x and SPFD5420 send one RGB565 word per
+// pixel. The MIPI controllers send three bytes per pixel, two pixels in
+// three words (R1 G1, B1 R2, G2 B2), with 6 bit colour left aligned in each
+// byte on the ILI9341 and 8 bit on the ILI9486, so the top bits serve both.
+void UTFT::readRect(int x, int y, int w, int h, uint16_t *out)
+{
+#if defined(STM32F107xC)
+	uint16_t	buf[UTFT_READ_BATCH];
+	int			dispx=(orient==PORTRAIT) ? disp_x_size : disp_y_size;
+	int			dispy=(orient==PORTRAIT) ? disp_y_size : disp_x_size;
+	int			x1=0, y1=0, x2=w-1, y2=h-1, len, run, step, next, cmd=0x2E, i;
+	long		left, k;
+	bool		packed=true;
+	uint16_t	a, b, *o;
+
+	if (x<0)
+		x1=-x;
+	if (y<0)
+		y1=-y;
+	if (x+x2>dispx)
+		x2=dispx-x;
+	if (y+y2>dispy)
+		y2=dispy-y;
+	if ((x1>x2) || (y1>y2))
+		return;
+	switch (display_model)
+	{
+	case ILI9320:
+	case ILI9325D_16:
+	case ILI9325D_16ALT:
+		cmd=0x22;
+		packed=false;
+		break;
+	case SPFD5420:
+		cmd=0x202;
+		packed=false;
+		break;
+	}
+
+	// portrait windows fill row by row, landscape ones column by column
+	// from the right
+	if (orient==PORTRAIT)
+	{
+		o=&out[y1*w+x1];
+		len=x2-x1+1;
+		step=1;
+		next=w-len+1;
+	}
+	else
+	{
+		o=&out[y1*w+x2];
+		len=y2-y1+1;
+		step=w;
+		next=-1-(len-1)*w;
+	}
+	run=len;
+	left=(long)(x2-x1+1)*(y2-y1+1);
+
+	cbi(P_CS, B_CS);
+	setXY(x+x1, y+y1, x+x2, y+y2);
+	LCD_Write_COM(cmd);
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_SET);
+	set_register(1);
+	_read_burst(buf, 1);		// dummy
+	while (left>0)
+	{
+		if (packed)
+		{
+			k=(left<UTFT_READ_BATCH/3*2) ? left : UTFT_READ_BATCH/3*2;
+			_read_burst(buf, (k*3+1)/2);
+		}
+		else
+		{
+			k=(left<UTFT_READ_BATCH) ? left : UTFT_READ_BATCH;
+			_read_burst(buf, k);
+		}
+		left-=k;
+		for (i=0; i<k; i++)
+		{
+			if (!packed)
+				*o=buf[i];
+			else if ((i & 1)==0)
+			{
+				a=buf[i/2*3];
+				b=buf[i/2*3+1];
+				*o=((a>>8) & 0xF8)<<8 | (a & 0xFC)<<3 | (b>>11);
+			}
+			else
+			{
+				b=buf[i/2*3+1];
+				a=buf[i/2*3+2];
+				*o=(b & 0xF8)<<8 | ((a>>8) & 0xFC)<<3 | (a & 0xF8)>>3;
+			}
+			if (--run==0)
+			{
+				o+=next;
+				run=len;
+			}
+			else
+				o+=step;
+		}
+	}
+	set_register(0);
+	sbi(P_CS, B_CS);
+	clrXY();
+#endif
+}
+
 void UTFT::setContrast(char c)
 {
 	cbi(P_CS, B_CS);
@@ -1523,6 +2573,255 @@ void UTFT::setWritePage(byte page)
 	sbi(P_CS, B_CS);
 }
 
+static volatile byte _te_edges;
+
+static void _te_isr()
+{
+	_te_edges++;
+}
+
+// Line the controller is scanning out, counted from the top in portrait
+uint16_t UTFT::_scanline()
+{
+	uint16_t	r[3];
+
+	_read_reg(0x45, r, 3);				// dummy, GTS[9:8], GTS[7:0]
+	return ((r[1] & 0x03)<<8) | (r[2] & 0xFF);
+}
+
+// Makes fills and bursts of UTFT_TE_MIN pixels or more wait for the panel's
+// scan (see _tear_wait()) when they are the first write after setXY(); one
+// further into the window would be sent back to its origin. pin is the input wired to the controller's TE
+// output, or -1 to poll the scan line instead. Returns the mode in use,
+// UTFT_TE_OFF when off or when the controller has no tearing effect output.
+byte UTFT::setTearSync(bool on, int pin)
+{
+	if (_tear==UTFT_TE_PIN)
+		detachInterrupt(digitalPinToInterrupt(_tear_pin));
+	_tear=UTFT_TE_OFF;
+	switch (display_model)
+	{
+	case ILI9341_16:
+	case ILI9481:
+	case ILI9486:
+	case R61581:
+		break;
+	default:
+		return UTFT_TE_OFF;
+	}
+
+	cbi(P_CS, B_CS);
+	if (on)
+	{
+		LCD_Write_COM(0x35);			// TEON, V-blank only
+		LCD_Write_DATA(0x00);
+	}
+	else
+		LCD_Write_COM(0x34);			// TEOFF
+	sbi(P_CS, B_CS);
+	if (!on)
+		return UTFT_TE_OFF;
+
+	if (pin>=0)
+	{
+		_tear_pin=pin;
+		pinMode(pin, INPUT);
+		attachInterrupt(digitalPinToInterrupt(pin), _te_isr, RISING);
+		_tear=UTFT_TE_PIN;
+	}
+	else
+		_tear=UTFT_TE_SCANLINE;
+	clrXY();
+	return _tear;
+}
+
+// Holds a large write until the scan has just passed the bottom of the
+// address window, so a whole refresh goes by before it is back at the top of
+// the window and the write races ahead of it. With a TE pin the controller
+// is asked (0x44) for the edge at the line below the window; without one the
+// scan line is polled until it is at most UTFT_TE_LATE lines past the window.
+// Either ends the GRAM write, so the window is set again.
+void UTFT::_tear_wait()
+{
+	unsigned long	start=millis();
+	uint16_t		y2=_tear_win[3], line;
+
+	if (_tear==UTFT_TE_PIN)
+	{
+		line=(y2<disp_y_size) ? y2+1 : 0;
+		LCD_Write_COM(0x44);
+		LCD_Write_DATA(line>>8);
+		LCD_Write_DATA(line & 0xFF);
+		_te_edges=0;
+		while ((_te_edges==0) && (millis()-start<UTFT_TE_TIMEOUT));
+	}
+	else
+	{
+		if (y2>disp_y_size)
+			y2=disp_y_size;
+		do
+		{
+			line=_scanline();
+			if ((line>y2) && (line<=y2+UTFT_TE_LATE))
+				break;
+			if ((y2+UTFT_TE_LATE>disp_y_size) && (line<y2+UTFT_TE_LATE-disp_y_size))
+				break;						// past the last line, in the blanking or back at the top
+		} while (millis()-start<UTFT_TE_TIMEOUT);
+	}
+	_setxy(this, _tear_win[0], _tear_win[1], _tear_win[2], _tear_win[3]);
+}
+
+// Display pages the controller holds, 1 where there is nothing to flip to
+byte UTFT::getPages()
+{
+	return (display_model==CPLD) ? 8 : 1;
+}
+
+// Draws a whole screen without showing it half done. With pages to spare it
+// is drawn on the hidden page, which is then shown; otherwise it goes out in
+// RAM bands (see below).
+byte UTFT::drawFrame(UTFT_Frame draw, void *arg)
+{
+	if ((getPages()>1) && (!_band))
+	{
+		setWritePage(_page^1);
+		draw(this, arg);
+		_page^=1;
+		setDisplayPage(_page);
+		return UTFT_FRAME_PAGED;
+	}
+	if (orient==PORTRAIT)
+		return drawFrame(draw, arg, 0, 0, disp_x_size+1, disp_y_size+1);
+	else
+		return drawFrame(draw, arg, 0, 0, disp_y_size+1, disp_x_size+1);
+}
+
+// Draws the area x, y, w, h UTFT_FRAME_BAND rows at a time: draw() renders
+// into a band in RAM, cleared to the back colour, and the band is sent in one
+// burst, so the LCD never shows overdraw or a half drawn frame. draw() is
+// called once per band with the colours and font it was given; what it puts
+// outside the area is dropped. GRAM is not read, so readRect() and sprites
+// see the screen as it was before the frame.
+byte UTFT::drawFrame(UTFT_Frame draw, void *arg, int x, int y, int w, int h)
+{
+	_frame_band		band;
+	_current_font	font=cfont;
+	byte			fh=fch, fl=fcl, bh=bch, bl=bcl;
+	boolean			trans=_transparent;
+	int				x1, y1, x2, y2, rows=UTFT_FRAME_BAND;
+	long			i, n;
+
+	if (orient==PORTRAIT)
+	{
+		x1=x;
+		x2=x+w-1;
+		y1=y;
+		y2=y+h-1;
+	}
+	else
+	{
+		x1=y;
+		x2=y+h-1;
+		y1=disp_y_size-(x+w-1);
+		y2=disp_y_size-x;
+	}
+	if (x1<0) x1=0;
+	if (y1<0) y1=0;
+	if (x2>disp_x_size) x2=disp_x_size;
+	if (y2>disp_y_size) y2=disp_y_size;
+	if ((x1>x2) || (y1>y2))
+		return UTFT_FRAME_BANDS;
+
+	band.buf=0;
+	while ((!_band) && (rows>0) && ((band.buf=(uint16_t *)malloc((long)(x2-x1+1)*rows*sizeof(uint16_t)))==0))
+		rows/=2;
+	if (!band.buf)
+	{
+		draw(this, arg);
+		return UTFT_FRAME_DIRECT;
+	}
+
+	band.x1=x1;
+	band.x2=x2;
+	for (band.y1=y1; band.y1<=y2; band.y1+=rows)
+	{
+		band.y2=(band.y1+rows-1<y2) ? band.y1+rows-1 : y2;
+		n=(long)(x2-x1+1)*(band.y2-band.y1+1);
+		for (i=0; i<n; i++)
+			band.buf[i]=(bh<<8)|bl;
+		band.wx1=band.cx=0;
+		band.wy1=band.cy=0;
+		band.wx2=disp_x_size;
+		band.wy2=disp_y_size;
+		cfont=font;
+		fch=fh;
+		fcl=fl;
+		bch=bh;
+		bcl=bl;
+		_transparent=trans;
+
+		_band=&band;
+		draw(this, arg);
+		_band=0;
+
+		cbi(P_CS, B_CS);
+		_set_window(x1, band.y1, x2, band.y2);
+		_burst_16(band.buf, n);
+		sbi(P_CS, B_CS);
+	}
+	free(band.buf);
+	clrXY();
+	return UTFT_FRAME_BANDS;
+}
+
+// One pixel at the band's write position, kept if it falls in the band
+void UTFT::_band_put(uint16_t color)
+{
+	_frame_band	*b=_band;
+
+	if ((b->cy>=b->y1) && (b->cy<=b->y2) && (b->cx>=b->x1) && (b->cx<=b->x2))
+		b->buf[(long)(b->cy-b->y1)*(b->x2-b->x1+1)+b->cx-b->x1]=color;
+	if (++b->cx>b->wx2)
+	{
+		b->cx=b->wx1;
+		if (++b->cy>b->wy2)
+			b->cy=b->wy1;
+	}
+}
+
+// pix pixels of one colour from the band's write position, a row piece at a time
+void UTFT::_band_fill(uint16_t color, long pix)
+{
+	_frame_band	*b=_band;
+	uint16_t	*p;
+	int			run, x1, x2;
+
+	while (pix>0)
+	{
+		run=b->wx2-b->cx+1;
+		if (run>pix)
+			run=pix;
+		if (run<1)
+			run=1;
+		if ((b->cy>=b->y1) && (b->cy<=b->y2))
+		{
+			x1=(b->cx>b->x1) ? b->cx : b->x1;
+			x2=(b->cx+run-1<b->x2) ? b->cx+run-1 : b->x2;
+			p=&b->buf[(long)(b->cy-b->y1)*(b->x2-b->x1+1)+x1-b->x1];
+			for (; x1<=x2; x1++)
+				*p++=color;
+		}
+		pix-=run;
+		b->cx+=run;
+		if (b->cx>b->wx2)
+		{
+			b->cx=b->wx1;
+			if (++b->cy>b->wy2)
+				b->cy=b->wy1;
+		}
+	}
+}
+
 #endif
 
 //#include "tft_drivers/ili9320/cpp.h"
@@ -84,6 +84,7 @@
 #define ST7735_ALT		31
 #define ILI9320			32
 #define SPFD5420		33
+#define UTFT_AUTO		255	// read the controller ID in Init() and pick the driver
 
 #define ITDB32			0	// HX8347-A (16bit)
 #define ITDB32WC		1	// ILI9327  (16bit)
@@ -151,6 +152,16 @@
 
 #define NOTINUSE		255
 
+#define UTFT_AUTO_FALLBACK	ILI9341_16	// driver used when no known controller answers
+
+// Controller init tables: a header byte per entry, the command and its
+// arguments, all in flash. Commands and arguments are bytes, or 16 bit words
+// (high byte first) when the header has UTFT_INIT_WORDS set.
+#define UTFT_INIT_ARGS		0x3F	// header: number of arguments
+#define UTFT_INIT_WORDS		0x40	// header: 16 bit command and arguments
+#define UTFT_INIT_DELAY		0x80	// entry is a delay, the next byte is in ms
+#define UTFT_INIT_END		0xFF
+
 //*********************************
 // COLORS
 //*********************************
@@ -178,14 +189,202 @@
 
 #include <Arduino.h> // This will include energia.h where appropriate
 #include "hardware/arm/HW_HALMX_defines.h"
+#include "UTFT_JPEG.h"
+
+// Packed (proportional) font layout, produced by extras/Tools/fontconv
+#define UTFT_PFONT_MAGIC	'P'
+#define UTFT_PFONT_HDR		16	// header size
+#define UTFT_PFONT_RANGE	8	// u32 first codepoint, u16 count, u16 first glyph
+#define UTFT_PFONT_GLYPH	8	// u24 bitmap, u8 w, u8 h, u8 advance, u8 xoff, u8 yoff
+#define UTFT_PFONT_RLE		0x01
+
+#define UTFT_FONT_BATCH		16	// glyphs resolved and prefetched per batch from a font source
+
+#define UTFT_UTF8_RAW		0xDC00	// utf8Next() returns a byte that is not valid UTF-8 as UTFT_UTF8_RAW+byte
+
+#define UTFT_SCALE_NEAREST	0
+#define UTFT_SCALE_EPX		1		// 2x smooth scaling, other sizes fall back to nearest
+#define UTFT_SCALE_LINE		320		// scaled rows are sent this many pixels at a time
+
+// Compressed images for drawImage(), produced by extras/Tools/imgpack
+#define UTFT_IMG_INDEXED	'I'		// u8 'I', u8 bpp, u16 width, u16 height, u8 colours-1, u8 flags,
+									// RGB565 palette, rows of 1/2/4/8 bit indices, MSB first, byte padded
+#define UTFT_IMG_RLE		'R'		// u8 'R', u8 16, u16 width, u16 height, u16 0, then u16 words:
+									// 1nnnnnnn nnnnnnnn colour = n+1 pixels of colour,
+									// 0nnnnnnn nnnnnnnn colours... = n+1 literal pixels
+#define UTFT_IMG_HDR		8
+#define UTFT_IMG_TRANSPARENT	0x01	// flags: palette entry 0 is not drawn
+
+// Images from and to the SD card (UTFT_SD.cpp, UTFT_Thumb.cpp; built when the sketch uses the SD library)
+#define UTFT_FILE_OK		0
+#define UTFT_FILE_OPEN		-1		// no such file or no card
+#define UTFT_FILE_FORMAT	-2		// not an image that can be drawn (e.g. raw RGB565 without a width), or damaged
+#define UTFT_FILE_NONE		-3		// drawThumbnail(): no thumbnail in the G-code header
+#define UTFT_FILE_MEMORY	-4		// no room for the PNG inflate window (or it exceeds UTFT_THUMB_WINDOW) or the JPEG decoder
+#define UTFT_FILE_UNSUPPORTED	-5	// progressive, arithmetic coded, 12 bit or CMYK JPEG
+#define UTFT_FILE_WRITE		-6		// saveScreenshot(): card full or write protected
+#define UTFT_SD_SECTOR		512
+#define UTFT_SHOT_BAND		8		// screen rows read back per band by saveScreenshot()
+#define UTFT_SHOT_LINE		48		// longest command line pollScreenshot() takes
+#define UTFT_THUMB_WINDOW	16384	// largest PNG inflate window allocated, bytes; PNGs that need more are refused
+#define UTFT_THUMB_SCAN		131072	// how far into a G-code file thumbnails are looked for
+
+#define UTFT_ROT_CLEAR		0xFFFFFFFF	// sampler result for pixels that are left untouched
+#define UTFT_ROT_SPAN		64		// pixels buffered per span of rotated output
+#define UTFT_ROT_GLYPH		512		// largest packed glyph cell that can be rotated, in bytes
+
+#define UTFT_PANEL_RECORD	8		// bytes a UTFT_PanelStore keeps: magic, ID register, ID, table sum, 0, check
+#define UTFT_PANEL_MAGIC	'L'
+
+#define UTFT_READ_BATCH		96		// GRAM words read per batch by readRect(), a multiple of 3
+#define UTFT_RD_LOW			355		// nRD low time of a GRAM read in ns (ILI9341 tRDLFM)
+#define UTFT_RST_LOW		1000	// reset pulse in us (ILI9325 needs 1 ms, ILI9341 10 us)
+
+#define UTFT_BUS_PROFILES	5		// bus timing profiles, see setBusProfile()
+#define UTFT_BUS_DEFAULT	3		// the profile used until another one is set
+#define UTFT_BUS_NONE		0xFF	// tuneBus(): no profile read back cleanly
+#define UTFT_BUS_LINE		320		// longest line tuneBus() writes and reads back per pattern
+#define UTFT_BUS_PASSES		7		// patterns checked per profile by tuneBus()
+
+#define UTFT_FRAME_BAND		16		// rows drawFrame() renders in RAM per pass on single page controllers
+#define UTFT_FRAME_PAGED	0		// drawFrame(): drawn on the hidden page, then flipped
+#define UTFT_FRAME_BANDS	1		// drawFrame(): drawn in RAM bands, each sent in one burst
+#define UTFT_FRAME_DIRECT	2		// drawFrame(): no memory for a band, drawn straight to the LCD
+
+#define UTFT_TE_OFF			0		// setTearSync(): writes go out at once
+#define UTFT_TE_PIN			1		// setTearSync(): large writes wait for the TE line
+#define UTFT_TE_SCANLINE	2		// setTearSync(): large writes poll the scan line (0x45)
+#define UTFT_TE_MIN			1024	// pixels from which a fill or burst at the window origin waits for the scan
+#define UTFT_TE_TIMEOUT		25		// ms after which a wait gives up, more than one refresh
+#define UTFT_TE_LATE		8		// scan lines past the window a polled wait still starts the write
+
+// The pixel loops run from RAM on the F107, clear of the flash wait states
+// (the linker script copies .ramfunc with .data). Build with UTFT_NO_RAMFUNC
+// to keep them in flash.
+#if defined(STM32F107xC) && !defined(UTFT_NO_RAMFUNC)
+#define UTFT_RAMFUNC		__attribute__((section(".ramfunc"), noinline, long_call))
+#define UTFT_FARCALL		__attribute__((long_call))		// flash code called from a UTFT_RAMFUNC
+#else
+#define UTFT_RAMFUNC
+#define UTFT_FARCALL
+#endif
+
+class UTFT;
+
+// Where a JPEG is drawn, the first member of each JPEG source's state
+struct _jpeg_target
+{
+	UTFT	*lcd;
+	int		x, y;
+};
+
+// Source of a rotated image for drawRotated(): returns the colour at (u,v)
+// or UTFT_ROT_CLEAR.
+typedef uint32_t (*UTFT_Sampler)(UTFT *lcd, const void *src, int u, int v);
+
+// Draws one frame for drawFrame(). May be called once per band, so it has to
+// draw the same thing every time.
+typedef void (*UTFT_Frame)(UTFT *lcd, void *arg);
+
+// RAM band drawFrame() renders into, and the address window and write
+// position the drawing functions see instead of the controller's, all in
+// portrait coordinates
+struct _frame_band
+{
+	uint16_t	*buf;
+	int			x1, y1, x2, y2;		// part of the screen held in buf
+	int			wx1, wy1, wx2, wy2;	// address window
+	int			cx, cy;				// next pixel
+};
+
+// Sets the controller's address window, in portrait coordinates, and starts a
+// GRAM write. Picked per model when the model is known (tft_drivers/*/setxy.cpp).
+typedef void (*UTFT_SetXY)(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+
+// What a controller needs after its init table that does not fit in one
+typedef void (*UTFT_InitDone)(UTFT *lcd);
+
+// A controller driver: the model, the ID it reads back for the ones UTFT_AUTO
+// can pick (0 for the rest), its size, transfer mode, init table and address
+// window routine. Each tft_drivers/*/driver.cpp registers its own with
+// UTFT_DRIVER(), and UTFT looks models and IDs up in the utft_drivers section.
+struct UTFT_Driver
+{
+	byte			model;
+	uint16_t		id;
+	uint16_t		xsize, ysize;		// disp_x_size, disp_y_size
+	byte			mode;				// display_transfer_mode
+	const uint8_t	*table;
+	UTFT_SetXY		setxy;
+	UTFT_InitDone	done;				// 0 when the table is all there is
+};
+
+// Aligned to the struct itself, so the section packs like an array
+#define UTFT_DRIVER_SECTION		__attribute__((section("utft_drivers"), aligned(__alignof__(UTFT_Driver))))
+#define UTFT_DRIVER_NAME(model)	_UTFT_DRIVER_NAME(model)
+#define _UTFT_DRIVER_NAME(n)	_utft_driver_##n
+#define UTFT_DRIVER(model, id, xsize, ysize, mode, table, setxy, done) \
+	extern const UTFT_Driver UTFT_DRIVER_NAME(model); \
+	const UTFT_Driver UTFT_DRIVER_NAME(model) UTFT_DRIVER_SECTION = {model, id, xsize, ysize, mode, table, setxy, done}
+
+// Drivers the build keeps. Where the linker script places utft_drivers itself
+// (MKS TFT) the section is garbage collected like any other, so only the
+// drivers this list points at are linked. The library's own list is weak and
+// holds the BSP_TFT_LCD controller, or all of them; a sketch replaces it at
+// file scope with e.g. UTFT_DRIVERS(ILI9341_16, ILI9486); (up to 8 models).
+extern const UTFT_Driver *const _utft_drivers_used[];
+
+#define UTFT_DRIVERS(...) \
+	_UTFT_EACH(_UTFT_DRIVER_DECL, __VA_ARGS__) \
+	const UTFT_Driver *const _utft_drivers_used[] = {_UTFT_EACH(_UTFT_DRIVER_REF, __VA_ARGS__) 0}
+#define _UTFT_DRIVER_DECL(model)	extern const UTFT_Driver UTFT_DRIVER_NAME(model);
+#define _UTFT_DRIVER_REF(model)		&UTFT_DRIVER_NAME(model),
+#define _UTFT_CAT(a, b)				_UTFT_CAT2(a, b)
+#define _UTFT_CAT2(a, b)			a##b
+#define _UTFT_COUNT(...)			_UTFT_NTH(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1)
+#define _UTFT_NTH(a1, a2, a3, a4, a5, a6, a7, a8, n, ...)	n
+#define _UTFT_EACH(f, ...)			_UTFT_CAT(_UTFT_EACH, _UTFT_COUNT(__VA_ARGS__))(f, __VA_ARGS__)
+#define _UTFT_EACH1(f, a)			f(a)
+#define _UTFT_EACH2(f, a, ...)		f(a) _UTFT_EACH1(f, __VA_ARGS__)
+#define _UTFT_EACH3(f, a, ...)		f(a) _UTFT_EACH2(f, __VA_ARGS__)
+#define _UTFT_EACH4(f, a, ...)		f(a) _UTFT_EACH3(f, __VA_ARGS__)
+#define _UTFT_EACH5(f, a, ...)		f(a) _UTFT_EACH4(f, __VA_ARGS__)
+#define _UTFT_EACH6(f, a, ...)		f(a) _UTFT_EACH5(f, __VA_ARGS__)
+#define _UTFT_EACH7(f, a, ...)		f(a) _UTFT_EACH6(f, __VA_ARGS__)
+#define _UTFT_EACH8(f, a, ...)		f(a) _UTFT_EACH7(f, __VA_ARGS__)
+
+// Font data that does not live in MCU memory (e.g. UTFT_FlashFont). Addresses
+// are offsets from the start of the font image.
+class UTFT_FontSource
+{
+	public:
+		virtual void	read(uint32_t addr, uint8_t *buf, uint16_t len) = 0;
+		virtual void	prefetch(const uint32_t * /*addr*/, const uint16_t * /*len*/, uint8_t /*n*/) {}
+};
+
+// A few bytes kept between boots, for the panel identity (UTFT_PanelEEPROM)
+class UTFT_PanelStore
+{
+	public:
+		virtual bool	load(uint8_t *buf, uint8_t len) = 0;
+		virtual void	save(const uint8_t *buf, uint8_t len) = 0;
+};
 
 struct _current_font
 {
 	uint8_t* font;
-	uint8_t x_size;
+	UTFT_FontSource* source;
+	uint8_t x_size;		// packed fonts: widest advance
 	uint8_t y_size;
 	uint8_t offset;
 	uint8_t numchars;
+	uint8_t packed;
+	uint8_t flags;
+	uint8_t ascent;
+	uint16_t nglyphs;
+	uint16_t nranges;
+	uint16_t fallback;
+	uint32_t bitmaps;
 };
 
 class UTFT
@@ -197,6 +396,13 @@ class UTFT
 #endif
 		UTFT(byte model, int RS, int WR, int CS, int RST, int SER=0);
 		void	Init(byte orientation=PORTRAIT);
+		void	initAsync(byte orientation=PORTRAIT);
+		bool	poll();
+		unsigned long	getInitTime();
+		void	setPanelStore(UTFT_PanelStore *store);
+		void	setBusProfile(byte profile);
+		byte	getBusProfile();
+		byte	tuneBus();
 		void	clrScr();
 		void	drawPixel(int x, int y);
 		void	drawLine(int x1, int y1, int x2, int y2);
@@ -216,15 +422,35 @@ class UTFT
 		uint16_t	getBackColor();
 		void	printStr(char *st, int x, int y, int deg=0);
 		void	printStr(const char *st, int x, int y, int deg=0); //huawei add
-		void	printStr(String st, int x, int y, int deg=0);
+		void	printStr(const String &st, int x, int y, int deg=0);
 		void	printNumI(long num, int x, int y, int length=0, char filler=' ');
 		void	printNumF(double num, byte dec, int x, int y, char divider='.', int length=0, char filler=' ');
+		void	printFixed(int32_t num, byte dec, int x, int y, char divider='.', int length=0, char filler=' ');
+		int		getFixedWidth(int32_t num, byte dec, int length=0);
+		int		formatFixed(char *buf, int32_t num, byte dec, char divider='.', int length=0, char filler=' ');
 		void	setFont(uint8_t* font);
+		void	setFont(UTFT_FontSource* source);
 		uint8_t* getFont();
 		uint8_t	 getFontXsize();
 		uint8_t	 getFontYsize();
+		int		getStrWidth(const char *st);
+		int		getStrWidth(const String &st);
+		static uint32_t	utf8Next(const char **st);
+		int		printGlyph(uint16_t glyph, int x, int y);
 		void	drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int scale=1);
-		void	drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int deg, int rox, int roy);
+		void	drawBitmap(int x, int y, int sx, int sy, bitmapdatatype data, int deg, int rox, int roy, uint32_t key=VGA_TRANSPARENT);
+		void	drawBitmapScaled(int x, int y, int sx, int sy, bitmapdatatype data, int dw, int dh, byte mode=UTFT_SCALE_NEAREST);
+		void	drawImage(int x, int y, const uint8_t *img);
+		int		drawJPEG(int x, int y, const uint8_t *data, uint32_t len, byte scale=UTFT_JPEG_FULL);
+#if __has_include(<SD.h>)
+		int		drawImageFromFile(const char *path, int x, int y, int sx=0);
+		int		drawJPEGFromFile(const char *path, int x, int y, byte scale=UTFT_JPEG_FULL);
+		int		drawThumbnail(const char *path, int x, int y, int w, int h);
+		int		saveScreenshot(const char *path);
+		void	pollScreenshot(Stream &port);
+#endif
+		void	drawRotated(int x, int y, int sx, int sy, int rox, int roy, int deg, UTFT_Sampler sample, const void *src);
+		void	readRect(int x, int y, int w, int h, uint16_t *out);
 		int		getDisplayXSize();
 		int		getDisplayYSize();
         int     readID(void);			  
@@ -241,6 +467,10 @@ class UTFT
 		void	setBrightness(byte br);
 		void	setDisplayPage(byte page);
 		void	setWritePage(byte page);
+		byte	getPages();
+		byte	drawFrame(UTFT_Frame draw, void *arg=0);
+		byte	drawFrame(UTFT_Frame draw, void *arg, int x, int y, int w, int h);
+		byte	setTearSync(bool on, int pin=-1);
 		void 	Blip(int numb);
 		
 #endif
@@ -261,6 +491,18 @@ class UTFT
 		byte			__p1, __p2, __p3, __p4, __p5; 
 		_current_font	cfont;
 		boolean			_transparent;
+		byte			_init_state;
+		const uint8_t	*_init_pos;
+		unsigned long	_init_start, _init_due, _init_ms;
+		UTFT_PanelStore	*_store;
+		UTFT_SetXY		_setxy;
+		byte			_bus_profile, _bus_pad;
+		byte			_page;
+		_frame_band		*_band;
+		byte			_tear;
+		int				_tear_pin;
+		uint16_t		_tear_win[4];
+		bool			_tear_origin;	// window just set, nothing written to it yet
 
 		void LCD_Writ_Bus(int VH,int VL, byte mode);
 		void LCD_Write_COM(int VL);
@@ -269,6 +511,12 @@ class UTFT
 		void LCD_Write_DATA(int VL);
 		void LCD_Write_COM_DATA(int com1,int dat1);
 		void _hw_special_init(void);
+		const uint8_t *_init_step(const uint8_t *t, uint16_t *ms);
+		void _init_table(const uint8_t *t);
+		void _read_reg(int cmd, uint16_t *buf, int n);
+		uint16_t _read_id(byte n);
+		uint16_t _probe_id(byte *reg);
+		uint16_t _identify();
 		void setPixel(uint16_t color);
 		void drawHLine(int x, int y, int l);
 		void drawVLine(int x, int y, int l);
@@ -276,9 +524,34 @@ class UTFT
 		void setXY(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 		void clrXY();
 		void rotateChar(byte c, int x, int y, int pos, int deg);
+		int _rotate_glyph(uint16_t glyph, int x, int y, int pen, int deg);
+		void _push_rows(int x, int y, int w, int rows, const uint16_t *line);
+		void _scale_epx(int x, int y, int sx, int sy, bitmapdatatype data);
+		void _draw_indexed(int x, int y, const uint8_t *img);
+		void _draw_rle(int x, int y, const uint8_t *img);
+		int _draw_jpeg(UTFT_JPEG_Read read, _jpeg_target *io, byte scale);
+		static void _jpeg_block(void *io, int x, int y, int w, int h, const uint16_t *pix);
+		uint8_t _font_byte(uint32_t addr);
+		void _font_read(uint32_t addr, uint8_t *buf, uint16_t len);
+		void _set_packed_font();
+		uint16_t _font_glyph(uint32_t cp);
+		void _font_prefetch(const char *st);
+		byte _legacy_char(uint32_t cp);
+		int _print_fixed(int32_t num, byte dec, int x, int y, char divider, int length, char filler, bool draw, char **out, bool sign_first=false);
+		int _num_char(char c, int x, int y, bool draw, char **out);
+		int _glyph_advance(uint16_t glyph);
 		void _set_direction_registers(byte mode);
-		void _fast_fill_16(int ch, int cl, long pix);
+		UTFT_RAMFUNC void _fast_fill_16(int ch, int cl, long pix);
 		void _fast_fill_8(int ch, long pix);
+		UTFT_RAMFUNC void _burst_16(const uint16_t *buf, long pix);
+		UTFT_RAMFUNC void _burst_le(const uint8_t *buf, long pix, bool reverse);
+		UTFT_RAMFUNC void _burst_bits(const uint8_t *bits, int n, bool reverse);
+		UTFT_FARCALL void _band_put(uint16_t color);
+		UTFT_FARCALL void _band_fill(uint16_t color, long pix);
+		UTFT_FARCALL void _tear_wait();
+		void _set_window(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+		uint16_t _scanline();
+		void _read_burst(uint16_t *buf, long n);
 		void _convert_float(char *buf, double num, int width, byte prec);
 
 #if defined(ENERGIA)
@@ -0,0 +1,175 @@
+/*
+  UTFT_Field.cpp - text field that only redraws the characters that changed
+*/
+
+#include "UTFT_Field.h"
+
+UTFT_Field::UTFT_Field(UTFT *lcd, int x, int y, uint8_t *font, uint16_t color, uint16_t back)
+{
+	_lcd=lcd;
+	_x=x;
+	_y=y;
+	_font=font;
+	_source=0;
+	_color=color;
+	_back=back;
+	_width=0;
+	_last[0]=0;
+}
+
+UTFT_Field::UTFT_Field(UTFT *lcd, int x, int y, UTFT_FontSource *source, uint16_t color, uint16_t back)
+{
+	_lcd=lcd;
+	_x=x;
+	_y=y;
+	_font=0;
+	_source=source;
+	_color=color;
+	_back=back;
+	_width=0;
+	_last[0]=0;
+}
+
+// Walks the new and the remembered string side by side. A character is
+// skipped when the same codepoint already sits at the same x position;
+// every glyph cell is drawn opaque over its full advance, so anything else
+// is simply drawn over.
+void UTFT_Field::print(const char *st)
+{
+	_current_font	save;
+	uint16_t		color, back;
+	boolean			transparent;
+	const char		*pn=st, *po=_last, *start;
+	char			next[UTFT_FIELD_LEN+1];
+	uint32_t		cn, co=0;
+	int				xn=_x, xo=_x, adv, len=0;
+	uint16_t		glyph=0;
+
+	_begin(&save, &color, &back, &transparent);
+	while (*pn)
+	{
+		start=pn;
+		cn=UTFT::utf8Next(&pn);
+		if (len+(pn-start)>UTFT_FIELD_LEN)
+			break;
+		while (start<pn)
+			next[len++]=*start++;
+
+		if (*po)
+			co=UTFT::utf8Next(&po);
+		if (_lcd->cfont.packed)
+		{
+			glyph=_lcd->_font_glyph(cn);
+			adv=_lcd->_glyph_advance(glyph);
+		}
+		else
+			adv=_lcd->cfont.x_size;
+
+		if ((cn!=co) || (xn!=xo))
+		{
+			if (_lcd->cfont.packed)
+				_lcd->printGlyph(glyph, xn, _y);
+			else
+				_lcd->printChar(_lcd->_legacy_char(cn), xn, _y);
+		}
+
+		xn+=adv;
+		if (co==cn)
+			xo+=adv;
+		else if (co)
+			xo+=(_lcd->cfont.packed) ? _lcd->_glyph_advance(_lcd->_font_glyph(co)) : _lcd->cfont.x_size;
+		co=0;
+	}
+	next[len]=0;
+
+	if (xn-_x<_width)
+	{
+		_lcd->setColor(_back);
+		_lcd->fillRect(xn, _y, _x+_width-1, _y+_lcd->cfont.y_size-1);
+	}
+	_width=xn-_x;
+	memcpy(_last, next, len+1);
+	_end(&save, color, back, transparent);
+}
+
+void UTFT_Field::print(const String &st)
+{
+	print(st.c_str());
+}
+
+// Same text as UTFT::printNumI()
+void UTFT_Field::printNumI(long num, int length, char filler)
+{
+	char	buf[UTFT_FIELD_LEN+1], *p=buf;
+
+	if (length>UTFT_FIELD_LEN)
+		length=UTFT_FIELD_LEN;
+	_lcd->_print_fixed(num, 0, 0, 0, '.', length, filler, false, &p, true);
+	*p=0;
+	print(buf);
+}
+
+void UTFT_Field::printFixed(int32_t num, byte dec, char divider, int length, char filler)
+{
+	char	buf[UTFT_FIELD_LEN+1];
+
+	if (length>UTFT_FIELD_LEN)
+		length=UTFT_FIELD_LEN;
+	_lcd->formatFixed(buf, num, dec, divider, length, filler);
+	print(buf);
+}
+
+void UTFT_Field::setColor(uint16_t color, uint16_t back)
+{
+	if ((color!=_color) || (back!=_back))
+	{
+		_color=color;
+		_back=back;
+		invalidate();
+	}
+}
+
+// Forgets what is on screen, the next print draws every character.
+void UTFT_Field::invalidate()
+{
+	_last[0]=0;
+}
+
+void UTFT_Field::clear()
+{
+	_current_font	save;
+	uint16_t		color, back;
+	boolean			transparent;
+
+	if (_width)
+	{
+		_begin(&save, &color, &back, &transparent);
+		_lcd->setColor(_back);
+		_lcd->fillRect(_x, _y, _x+_width-1, _y+_lcd->cfont.y_size-1);
+		_end(&save, color, back, transparent);
+	}
+	_width=0;
+	_last[0]=0;
+}
+
+void UTFT_Field::_begin(_current_font *save, uint16_t *color, uint16_t *back, boolean *transparent)
+{
+	*save=_lcd->cfont;
+	*color=_lcd->getColor();
+	*back=_lcd->getBackColor();
+	*transparent=_lcd->_transparent;
+	if (_source)
+		_lcd->setFont(_source);
+	else
+		_lcd->setFont(_font);
+	_lcd->setColor(_color);
+	_lcd->setBackColor(_back);
+}
+
+void UTFT_Field::_end(_current_font *save, uint16_t color, uint16_t back, boolean transparent)
+{
+	_lcd->cfont=*save;
+	_lcd->setColor(color);
+	_lcd->setBackColor(back);
+	_lcd->_transparent=transparent;
+}
@@ -0,0 +1,49 @@
+/*
+  UTFT_Field.h - text field that only redraws the characters that changed
+
+  A field remembers the last string it drew at a fixed position with a
+  fixed font and colours. On the next update only the character cells
+  whose content or position changed are drawn again, and the cells left
+  over when the string gets shorter are cleared. Works with the fixed
+  cell fonts and with packed proportional fonts; text is left aligned
+  and always drawn opaque.
+
+    UTFT_Field temp(&myGLCD, 10, 40, BigFont, WHITE, BLACK);
+    temp.printFixed(2053, 1);		// "205.3"
+*/
+
+#ifndef __UTFT_FIELD_H__
+#define __UTFT_FIELD_H__
+
+#include "UTFT.h"
+
+#define UTFT_FIELD_LEN	32		// longest string a field remembers, in bytes
+
+class UTFT_Field
+{
+	public:
+		UTFT_Field(UTFT *lcd, int x, int y, uint8_t *font, uint16_t color=WHITE, uint16_t back=BLACK);
+		UTFT_Field(UTFT *lcd, int x, int y, UTFT_FontSource *source, uint16_t color=WHITE, uint16_t back=BLACK);
+
+		void	print(const char *st);
+		void	print(const String &st);
+		void	printNumI(long num, int length=0, char filler=' ');
+		void	printFixed(int32_t num, byte dec, char divider='.', int length=0, char filler=' ');
+		void	setColor(uint16_t color, uint16_t back);
+		void	invalidate();
+		void	clear();
+
+	private:
+		UTFT				*_lcd;
+		int					_x, _y;
+		uint8_t				*_font;
+		UTFT_FontSource		*_source;
+		uint16_t			_color, _back;
+		int					_width;					// pixel width of the last string
+		char				_last[UTFT_FIELD_LEN+1];
+
+		void	_begin(_current_font *save, uint16_t *color, uint16_t *back, boolean *transparent);
+		void	_end(_current_font *save, uint16_t color, uint16_t back, boolean transparent);
+};
+
+#endif
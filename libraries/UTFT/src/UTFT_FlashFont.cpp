@@ -0,0 +1,221 @@
+/*
+  UTFT_FlashFont.cpp - packed fonts stored on the external SPI NOR flash
+*/
+
+#include "UTFT_FlashFont.h"
+#include "delay/User_delay.h"
+
+#define FLASH_READ			0x03
+#define FLASH_PAGE_PROGRAM	0x02
+#define FLASH_SECTOR_ERASE	0x20
+#define FLASH_WRITE_ENABLE	0x06
+#define FLASH_READ_STATUS	0x05
+#define FLASH_RELEASE_PD	0xAB
+#define FLASH_STATUS_BUSY	0x01
+#define FLASH_RELEASE_US	3		// tRES1 of the W25Q parts
+
+struct _flash_page
+{
+	uint32_t	tag;		// page number + 1, 0 when the slot is empty
+	uint32_t	stamp;		// LRU age, larger is more recent
+	uint8_t		data[UTFT_FLASHFONT_PAGE];
+};
+
+static _flash_page	_cache[UTFT_FLASHFONT_PAGES];
+static uint32_t		_clock;
+static uint8_t		_last;		// most recently used slot, checked first
+
+UTFT_FlashFont::UTFT_FlashFont(uint32_t base, int cs, SPIClass &spi)
+{
+	_base=base;
+	_cs=cs;
+	_spi=&spi;
+}
+
+bool UTFT_FlashFont::begin()
+{
+	uint8_t		h[2];
+
+	pinMode(_cs, OUTPUT);
+	digitalWrite(_cs, HIGH);
+	_spi->begin();
+	_command(FLASH_RELEASE_PD);
+	USER_delay_us(FLASH_RELEASE_US);
+	read(0, h, 2);
+	return (h[0]==0) && (h[1]==UTFT_PFONT_MAGIC);
+}
+
+void UTFT_FlashFont::invalidate()
+{
+	for (uint8_t i=0; i<UTFT_FLASHFONT_PAGES; i++)
+		_cache[i].tag=0;
+}
+
+void UTFT_FlashFont::read(uint32_t addr, uint8_t *buf, uint16_t len)
+{
+	uint32_t	a=_base+addr;
+	uint16_t	off, n;
+
+	while (len)
+	{
+		off=a % UTFT_FLASHFONT_PAGE;
+		n=UTFT_FLASHFONT_PAGE-off;
+		if (n>len)
+			n=len;
+		memcpy(buf, _page(a/UTFT_FLASHFONT_PAGE)+off, n);
+		buf+=n;
+		a+=n;
+		len-=n;
+	}
+}
+
+// Collects the pages behind the given spans that are not cached yet and
+// reads each run of consecutive pages with a single READ command.
+void UTFT_FlashFont::prefetch(const uint32_t *addr, const uint16_t *len, uint8_t n)
+{
+	uint32_t	want[UTFT_FLASHFONT_PAGES];
+	uint8_t		nwant=0, i, j, k;
+
+	for (i=0; i<n; i++)
+	{
+		uint32_t first=(_base+addr[i])/UTFT_FLASHFONT_PAGE;
+		uint32_t last=(_base+addr[i]+(len[i] ? len[i]-1 : 0))/UTFT_FLASHFONT_PAGE;
+		for (uint32_t p=first; p<=last; p++)
+		{
+			for (k=0; k<UTFT_FLASHFONT_PAGES; k++)
+				if (_cache[k].tag==p+1)
+					break;
+			if (k<UTFT_FLASHFONT_PAGES)
+			{
+				_cache[k].stamp=++_clock;	// keep it out of the way of the fill below
+				continue;
+			}
+			for (k=0; (k<nwant) && (want[k]!=p); k++);
+			if ((k==nwant) && (nwant<UTFT_FLASHFONT_PAGES))
+				want[nwant++]=p;
+		}
+	}
+
+	for (i=1; i<nwant; i++)
+		for (j=i; (j>0) && (want[j-1]>want[j]); j--)
+		{
+			uint32_t t=want[j];
+			want[j]=want[j-1];
+			want[j-1]=t;
+		}
+
+	for (i=0; i<nwant; i=j)
+	{
+		for (j=i+1; (j<nwant) && (want[j]==want[j-1]+1); j++);
+		_fill(want[i], j-i);
+	}
+}
+
+uint8_t *UTFT_FlashFont::_page(uint32_t page)
+{
+	if (_cache[_last].tag!=page+1)
+	{
+		uint8_t i;
+		for (i=0; (i<UTFT_FLASHFONT_PAGES) && (_cache[i].tag!=page+1); i++);
+		if (i<UTFT_FLASHFONT_PAGES)
+			_last=i;
+		else
+			_fill(page, 1);
+	}
+	_cache[_last].stamp=++_clock;
+	return _cache[_last].data;
+}
+
+// Reads count consecutive pages into the least recently used slots.
+void UTFT_FlashFont::_fill(uint32_t first, uint8_t count)
+{
+	_select(FLASH_READ, first*UTFT_FLASHFONT_PAGE);
+	while (count--)
+	{
+		uint8_t victim=0;
+		for (uint8_t i=1; i<UTFT_FLASHFONT_PAGES; i++)
+			if (_cache[i].stamp<_cache[victim].stamp)
+				victim=i;
+		_spi->transfer(_cache[victim].data, UTFT_FLASHFONT_PAGE);
+		_cache[victim].tag=first+1;
+		_cache[victim].stamp=++_clock;
+		_last=victim;
+		first++;
+	}
+	_deselect();
+}
+
+void UTFT_FlashFont::erase(uint32_t len)
+{
+	for (uint32_t a=_base & ~(uint32_t)(UTFT_FLASHFONT_SECTOR-1); a<_base+len; a+=UTFT_FLASHFONT_SECTOR)
+	{
+		_command(FLASH_WRITE_ENABLE);
+		_select(FLASH_SECTOR_ERASE, a);
+		_deselect();
+		_wait_ready();
+	}
+	invalidate();
+}
+
+void UTFT_FlashFont::program(uint32_t addr, const uint8_t *buf, uint16_t len)
+{
+	uint32_t	a=_base+addr;
+	uint16_t	n;
+
+	while (len)
+	{
+		n=UTFT_FLASHFONT_PAGE-(a % UTFT_FLASHFONT_PAGE);
+		if (n>len)
+			n=len;
+		_command(FLASH_WRITE_ENABLE);
+		_select(FLASH_PAGE_PROGRAM, a);
+		for (uint16_t i=0; i<n; i++)
+			_spi->transfer(buf[i]);
+		_deselect();
+		_wait_ready();
+		buf+=n;
+		a+=n;
+		len-=n;
+	}
+	invalidate();
+}
+
+void UTFT_FlashFont::_select(uint8_t cmd, uint32_t addr)
+{
+	_spi->beginTransaction(SPISettings(UTFT_FLASHFONT_SPEED, MSBFIRST, SPI_MODE0));
+	digitalWrite(_cs, LOW);
+	_spi->transfer(cmd);
+	_spi->transfer(addr>>16);
+	_spi->transfer(addr>>8);
+	_spi->transfer(addr);
+}
+
+void UTFT_FlashFont::_deselect()
+{
+	digitalWrite(_cs, HIGH);
+	_spi->endTransaction();
+}
+
+void UTFT_FlashFont::_command(uint8_t cmd)
+{
+	_spi->beginTransaction(SPISettings(UTFT_FLASHFONT_SPEED, MSBFIRST, SPI_MODE0));
+	digitalWrite(_cs, LOW);
+	_spi->transfer(cmd);
+	digitalWrite(_cs, HIGH);
+	_spi->endTransaction();
+}
+
+void UTFT_FlashFont::_wait_ready()
+{
+	uint8_t		st;
+
+	do
+	{
+		_spi->beginTransaction(SPISettings(UTFT_FLASHFONT_SPEED, MSBFIRST, SPI_MODE0));
+		digitalWrite(_cs, LOW);
+		_spi->transfer(FLASH_READ_STATUS);
+		st=_spi->transfer(0);
+		digitalWrite(_cs, HIGH);
+		_spi->endTransaction();
+	} while (st & FLASH_STATUS_BUSY);
+}
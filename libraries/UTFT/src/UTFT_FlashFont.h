@@ -0,0 +1,56 @@
+/*
+  UTFT_FlashFont.h - packed fonts stored on the external SPI NOR flash
+
+  The font image is the binary output of extras/Tools/fontconv
+  (-f packed --bin) written at any address of the W25Qxx flash on
+  FLASH_CS. Glyph data is paged in on demand through a small LRU cache
+  shared by all flash fonts, so large UTF-8/CJK fonts cost no MCU flash:
+
+    UTFT_FlashFont cjk16(0x100000);
+    cjk16.begin();
+    myGLCD.setFont(&cjk16);
+*/
+
+#ifndef __UTFT_FLASHFONT_H__
+#define __UTFT_FLASHFONT_H__
+
+#include "UTFT.h"
+#include <SPI.h>
+
+#define UTFT_FLASHFONT_PAGE		256		// cache page size, one NOR program page
+#define UTFT_FLASHFONT_PAGES	8		// cache pages shared by all flash fonts
+#define UTFT_FLASHFONT_SECTOR	4096	// erase granularity
+#define UTFT_FLASHFONT_SPEED	18000000
+
+class UTFT_FlashFont : public UTFT_FontSource
+{
+	public:
+#ifdef FLASH_CS
+		UTFT_FlashFont(uint32_t base, int cs=FLASH_CS, SPIClass &spi=SPI);
+#else
+		UTFT_FlashFont(uint32_t base, int cs, SPIClass &spi=SPI);
+#endif
+		bool	begin();
+		void	read(uint32_t addr, uint8_t *buf, uint16_t len);
+		void	prefetch(const uint32_t *addr, const uint16_t *len, uint8_t n);
+
+		// Writing a font image, e.g. streamed from the SD card
+		void	erase(uint32_t len);
+		void	program(uint32_t addr, const uint8_t *buf, uint16_t len);
+
+		static void	invalidate();
+
+	private:
+		uint32_t	_base;
+		int			_cs;
+		SPIClass	*_spi;
+
+		uint8_t		*_page(uint32_t page);
+		void		_fill(uint32_t first, uint8_t count);
+		void		_select(uint8_t cmd, uint32_t addr);
+		void		_deselect();
+		void		_command(uint8_t cmd);
+		void		_wait_ready();
+};
+
+#endif
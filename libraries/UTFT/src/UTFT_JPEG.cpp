@@ -0,0 +1,596 @@
+/*
+  UTFT_JPEG.cpp - small baseline JPEG decoder
+*/
+
+#include "UTFT_JPEG.h"
+#include <string.h>
+
+static const uint8_t _zigzag[64]=
+{
+	 0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+	12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+	35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+	58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static inline uint8_t _clamp(int v)
+{
+	return (v<0) ? 0 : (v>255) ? 255 : v;
+}
+
+// Reads the headers up to the start of the first scan
+int UTFT_JPEG::begin(UTFT_JPEG_Read read, void *io)
+{
+	int c, res;
+
+	memset(this, 0, sizeof(*this));
+	_read=read;
+	_io=io;
+	if ((_byte()!=0xFF) || (_byte()!=0xD8))
+		return UTFT_JPEG_FORMAT;
+	for (;;)
+	{
+		c=_byte();
+		if (c!=0xFF)
+		{
+			if (c<0)
+				return UTFT_JPEG_FORMAT;
+			continue;
+		}
+		while (c==0xFF)
+			c=_byte();
+		if ((c<0) || (c==0xD9))
+			return UTFT_JPEG_FORMAT;
+		res=_segment(c);
+		if (res!=UTFT_JPEG_OK)
+			return res;
+		if (c==0xDA)
+			return UTFT_JPEG_OK;
+	}
+}
+
+int UTFT_JPEG::getWidth(uint8_t scale)
+{
+	return (_width+(1<<scale)-1)>>scale;
+}
+
+int UTFT_JPEG::getHeight(uint8_t scale)
+{
+	return (_height+(1<<scale)-1)>>scale;
+}
+
+int UTFT_JPEG::_byte()
+{
+	if (_pos==_len)
+	{
+		_pos=0;
+		_len=_read(_io, _buf, UTFT_JPEG_BUF);
+		if (_len<=0)
+		{
+			_len=0;
+			return -1;
+		}
+	}
+	return _buf[_pos++];
+}
+
+int UTFT_JPEG::_word()
+{
+	int hi=_byte(), lo=_byte();
+
+	return ((hi<0) || (lo<0)) ? -1 : (hi<<8) | lo;
+}
+
+int UTFT_JPEG::_segment(int marker)
+{
+	int len=_word()-2;
+
+	if (len<0)
+		return UTFT_JPEG_FORMAT;
+	switch (marker)
+	{
+	case 0xDB:
+		return _dqt(len);
+	case 0xC4:
+		return _dht(len);
+	case 0xC0:
+	case 0xC1:
+		return _sof(len);
+	case 0xDA:
+		return _sos(len);
+	case 0xDD:
+		_restart=_word();
+		return UTFT_JPEG_OK;
+	}
+	if ((marker>=0xC2) && (marker<=0xCF))
+		return UTFT_JPEG_UNSUPPORTED;
+	while (len--)
+		if (_byte()<0)
+			return UTFT_JPEG_FORMAT;
+	return UTFT_JPEG_OK;
+}
+
+int UTFT_JPEG::_dqt(int len)
+{
+	int i, pq, prec;
+
+	while (len>0)
+	{
+		pq=_byte();
+		prec=pq>>4;
+		for (i=0; i<64; i++)
+			_quant[pq & 3][i]=prec ? _word() : _byte();
+		len-=1+(prec ? 128 : 64);
+	}
+	return (len==0) ? UTFT_JPEG_OK : UTFT_JPEG_FORMAT;
+}
+
+// Builds the canonical code tables of JPEG annex C, plus a lookup by the
+// next 8 bits that resolves all the short codes in one step
+int UTFT_JPEG::_dht(int len)
+{
+	uint8_t		counts[16];
+	_jpeg_huff	*h;
+	int			i, j, l, tc, total, k, code;
+
+	while (len>0)
+	{
+		tc=_byte();
+		h=&_huff[((tc & 0x10) ? 2 : 0)+(tc & 1)];
+		for (i=0, total=0; i<16; i++)
+			total+=counts[i]=_byte();
+		if (total>256)
+			return UTFT_JPEG_FORMAT;
+		for (i=0; i<total; i++)
+			h->val[i]=_byte();
+		len-=17+total;
+
+		memset(h->fast, 0, sizeof(h->fast));
+		for (l=1, k=0, code=0; l<=16; l++)
+		{
+			h->valptr[l]=k;
+			h->mincode[l]=code;
+			for (i=0; i<counts[l-1]; i++, k++, code++)
+			{
+				if (code>=(1<<l))
+					return UTFT_JPEG_FORMAT;
+				if (l<=8)
+					for (j=0; j<(1<<(8-l)); j++)
+						h->fast[(code<<(8-l)) | j]=(l<<8) | h->val[k];
+			}
+			h->maxcode[l]=counts[l-1] ? code-1 : -1;
+			code<<=1;
+		}
+	}
+	return (len==0) ? UTFT_JPEG_OK : UTFT_JPEG_FORMAT;
+}
+
+int UTFT_JPEG::_sof(int len)
+{
+	int			i, hv;
+	_jpeg_comp	*c;
+
+	if (_byte()!=8)
+		return UTFT_JPEG_UNSUPPORTED;
+	_height=_word();
+	_width=_word();
+	_ncomp=_byte();
+	if ((_ncomp!=1) && (_ncomp!=3))
+		return UTFT_JPEG_UNSUPPORTED;
+	if ((_width<=0) || (_height<=0) || (len!=6+_ncomp*3))
+		return UTFT_JPEG_FORMAT;
+	_hmax=_vmax=1;
+	for (i=0; i<_ncomp; i++)
+	{
+		c=&_comp[i];
+		c->id=_byte();
+		hv=_byte();
+		c->tq=_byte() & 3;
+		c->hs=(_ncomp==1) ? 1 : hv>>4;		// a single component scan is never interleaved
+		c->vs=(_ncomp==1) ? 1 : hv & 15;
+		if ((c->hs<1) || (c->hs>2) || (c->vs<1) || (c->vs>2))
+			return UTFT_JPEG_UNSUPPORTED;
+		if (c->hs>_hmax)
+			_hmax=c->hs;
+		if (c->vs>_vmax)
+			_vmax=c->vs;
+	}
+	return UTFT_JPEG_OK;
+}
+
+int UTFT_JPEG::_sos(int len)
+{
+	int i, j, id, t;
+
+	if ((_ncomp==0) || (_byte()!=_ncomp) || (len!=4+_ncomp*2))
+		return _ncomp ? UTFT_JPEG_UNSUPPORTED : UTFT_JPEG_FORMAT;
+	for (i=0; i<_ncomp; i++)
+	{
+		id=_byte();
+		t=_byte();
+		for (j=0; (j<_ncomp) && (_comp[j].id!=id); j++)
+			;
+		if (j==_ncomp)
+			return UTFT_JPEG_FORMAT;
+		_comp[j].td=(t>>4) & 1;
+		_comp[j].ta=t & 1;
+	}
+	_byte();		// spectral selection and successive approximation,
+	_byte();		// fixed for baseline
+	_byte();
+	return UTFT_JPEG_OK;
+}
+
+/*********************** entropy decoding ***********************/
+
+// Tops up the bit buffer, removing the stuffed zero after 0xFF. At a marker
+// the data ends and zeros are fed instead.
+void UTFT_JPEG::_fill()
+{
+	int b, n;
+
+	while (_nbits<=24)
+	{
+		b=0;
+		if (!_marker)
+		{
+			b=_byte();
+			if (b==0xFF)
+			{
+				do
+					n=_byte();
+				while (n==0xFF);
+				if (n!=0)
+				{
+					_marker=(n<0) ? 0xD9 : n;
+					b=0;
+				}
+			}
+			else if (b<0)
+			{
+				_marker=0xD9;
+				b=0;
+			}
+		}
+		_bits|=(uint32_t)b<<(24-_nbits);
+		_nbits+=8;
+	}
+}
+
+int UTFT_JPEG::_getbits(int n)
+{
+	int v;
+
+	if (n==0)
+		return 0;
+	if (_nbits<n)
+		_fill();
+	v=_bits>>(32-n);
+	_bits<<=n;
+	_nbits-=n;
+	return v;
+}
+
+int UTFT_JPEG::_decode(const _jpeg_huff *h)
+{
+	int			e, l;
+	uint32_t	code;
+
+	if (_nbits<16)
+		_fill();
+	e=h->fast[_bits>>24];
+	if (e)
+	{
+		_bits<<=e>>8;
+		_nbits-=e>>8;
+		return e & 0xFF;
+	}
+	for (l=9; l<=16; l++)
+	{
+		code=_bits>>(32-l);
+		if ((int32_t)code<=h->maxcode[l])
+		{
+			_bits<<=l;
+			_nbits-=l;
+			return h->val[h->valptr[l]+code-h->mincode[l]];
+		}
+	}
+	_err=true;
+	return -1;
+}
+
+static inline int _extend(int v, int s)
+{
+	return (v<(1<<(s-1))) ? v-(1<<s)+1 : v;
+}
+
+// One 8x8 block into _coef
+bool UTFT_JPEG::_block(_jpeg_comp *c)
+{
+	const uint16_t	*q=_quant[c->tq];
+	const _jpeg_huff	*ac=&_huff[2+c->ta];
+	int				k, s, rs;
+
+	memset(_coef, 0, sizeof(_coef));
+	s=_decode(&_huff[c->td]);
+	if ((s<0) || (s>15))
+		return false;
+	if (s)
+		c->pred+=_extend(_getbits(s), s);
+	if ((c->pred<-32768) || (c->pred>32767))
+		return false;
+	_coef[0]=c->pred*q[0];
+	for (k=1; k<64; )
+	{
+		rs=_decode(ac);
+		if (rs<0)
+			return false;
+		s=rs & 15;
+		if (s==0)
+		{
+			if (rs!=0xF0)
+				break;					// end of block
+			k+=16;
+			continue;
+		}
+		k+=rs>>4;
+		if (k>63)
+			return false;
+		_coef[_zigzag[k]]=_extend(_getbits(s), s)*q[k];
+		k++;
+	}
+	return true;
+}
+
+// Drops the padding bits and moves past the next RSTn marker
+bool UTFT_JPEG::_next_restart()
+{
+	int b;
+
+	_bits=0;
+	_nbits=0;
+	while (!_marker)
+	{
+		b=_byte();
+		if (b<0)
+			return false;
+		if (b==0xFF)
+		{
+			do
+				b=_byte();
+			while (b==0xFF);
+			if (b<0)
+				return false;
+			_marker=b;
+		}
+	}
+	if ((_marker<0xD0) || (_marker>0xD7))
+		return false;
+	_marker=0;
+	for (b=0; b<_ncomp; b++)
+		_comp[b].pred=0;
+	return true;
+}
+
+/***************************** IDCT *****************************/
+
+// Integer IDCT after the LLM factorisation used by libjpeg's jidctint.c, with
+// 12 bit constants (as in stb_image). Columns whose AC terms are all zero
+// take the shortcut.
+#define IDCT_1D(s0, s1, s2, s3, s4, s5, s6, s7) \
+	int t0, t1, t2, t3, p1, p2, p3, p4, p5, x0, x1, x2, x3; \
+	p2=s2; \
+	p3=s6; \
+	p1=(p2+p3)*2217; \
+	t2=p1+p3*-7567; \
+	t3=p1+p2*3135; \
+	p2=s0; \
+	p3=s4; \
+	t0=(p2+p3)*4096; \
+	t1=(p2-p3)*4096; \
+	x0=t0+t3; \
+	x3=t0-t3; \
+	x1=t1+t2; \
+	x2=t1-t2; \
+	t0=s7; \
+	t1=s5; \
+	t2=s3; \
+	t3=s1; \
+	p3=t0+t2; \
+	p4=t1+t3; \
+	p1=t0+t3; \
+	p2=t1+t2; \
+	p5=(p3+p4)*4816; \
+	t0=t0*1223; \
+	t1=t1*8410; \
+	t2=t2*12586; \
+	t3=t3*6149; \
+	p1=p5+p1*-3685; \
+	p2=p5+p2*-10497; \
+	p3=p3*-8034; \
+	p4=p4*-1597; \
+	t3+=p1+p4; \
+	t2+=p2+p3; \
+	t1+=p2+p4; \
+	t0+=p1+p3;
+
+void UTFT_JPEG::_idct(uint8_t *out)
+{
+	int		i, val[64], *v=val;
+	int		*d=_coef;
+
+	for (i=0; i<8; i++, d++, v++)
+	{
+		if ((d[8]==0) && (d[16]==0) && (d[24]==0) && (d[32]==0) && (d[40]==0) && (d[48]==0) && (d[56]==0))
+		{
+			v[0]=v[8]=v[16]=v[24]=v[32]=v[40]=v[48]=v[56]=d[0]*4;
+			continue;
+		}
+		IDCT_1D(d[0], d[8], d[16], d[24], d[32], d[40], d[48], d[56])
+		x0+=512;
+		x1+=512;
+		x2+=512;
+		x3+=512;
+		v[0]=(x0+t3)>>10;
+		v[56]=(x0-t3)>>10;
+		v[8]=(x1+t2)>>10;
+		v[48]=(x1-t2)>>10;
+		v[16]=(x2+t1)>>10;
+		v[40]=(x2-t1)>>10;
+		v[24]=(x3+t0)>>10;
+		v[32]=(x3-t0)>>10;
+	}
+	// 12 bit constants, 2 extra bits from the columns and 3 from the two
+	// sqrt(8) scalings: 17 bits come off, with rounding and the +128 level
+	for (i=0, v=val; i<8; i++, v+=8, out+=8)
+	{
+		IDCT_1D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7])
+		x0+=65536+(128<<17);
+		x1+=65536+(128<<17);
+		x2+=65536+(128<<17);
+		x3+=65536+(128<<17);
+		out[0]=_clamp((x0+t3)>>17);
+		out[7]=_clamp((x0-t3)>>17);
+		out[1]=_clamp((x1+t2)>>17);
+		out[6]=_clamp((x1-t2)>>17);
+		out[2]=_clamp((x2+t1)>>17);
+		out[5]=_clamp((x2-t1)>>17);
+		out[3]=_clamp((x3+t0)>>17);
+		out[4]=_clamp((x3-t0)>>17);
+	}
+}
+
+/*************************** MCU output ***************************/
+
+// Writes the block in _coef as bw x bh samples: the full IDCT, its average
+// over 2x2 .. 8x8 cells when reducing, or just the DC term for 1x1
+void UTFT_JPEG::_block_out(uint8_t *dst, int stride, int bw, int bh)
+{
+	uint8_t	tmp[64];
+	int		x, y, i, j, nx, ny, sum, shift;
+
+	if ((bw==1) && (bh==1))
+	{
+		*dst=_clamp(((_coef[0]+4)>>3)+128);
+		return;
+	}
+	_idct(tmp);
+	if ((bw==8) && (bh==8))
+	{
+		for (y=0; y<8; y++)
+			memcpy(&dst[y*stride], &tmp[y*8], 8);
+		return;
+	}
+	nx=8/bw;
+	ny=8/bh;
+	for (shift=0; (1<<shift)<nx*ny; shift++)
+		;
+	for (y=0; y<bh; y++)
+		for (x=0; x<bw; x++)
+		{
+			for (j=0, sum=0; j<ny; j++)
+				for (i=0; i<nx; i++)
+					sum+=tmp[(y*ny+j)*8+x*nx+i];
+			dst[y*stride+x]=(sum+(1<<shift)/2)>>shift;
+		}
+}
+
+// Colour converts the component planes of one MCU into _pix. Chroma that
+// is still coarser than the output is repeated.
+void UTFT_JPEG::_mcu_pixels(int w, int h)
+{
+	const uint8_t	*py, *pb, *pr;
+	int				x, y, yy, cb, cr, r, g, b;
+	_jpeg_comp		*c=_comp;
+	uint16_t		*o=_pix;
+
+	for (y=0; y<h; y++)
+	{
+		py=&_plane[0][(y>>c[0].uy)*c[0].hs*c[0].bw];
+		if (_ncomp==1)
+		{
+			for (x=0; x<w; x++)
+			{
+				yy=py[x];
+				*o++=((yy & 0xF8)<<8) | ((yy & 0xFC)<<3) | (yy>>3);
+			}
+			continue;
+		}
+		pb=&_plane[1][(y>>c[1].uy)*c[1].hs*c[1].bw];
+		pr=&_plane[2][(y>>c[2].uy)*c[2].hs*c[2].bw];
+		for (x=0; x<w; x++)
+		{
+			yy=py[x>>c[0].ux];
+			cb=pb[x>>c[1].ux]-128;
+			cr=pr[x>>c[2].ux]-128;
+			r=_clamp(yy+((91881*cr+32768)>>16));
+			g=_clamp(yy+((32768-22553*cb-46802*cr)>>16));
+			b=_clamp(yy+((116130*cb+32768)>>16));
+			*o++=((r & 0xF8)<<8) | ((g & 0xFC)<<3) | (b>>3);
+		}
+	}
+}
+
+// Decodes the scan, handing each MCU to out as it is finished. scale
+// divides the size by 1, 2, 4 or 8. Subsampled chroma is reduced less than
+// luma, so it keeps its own resolution as long as the output allows.
+int UTFT_JPEG::decode(UTFT_JPEG_Block out, uint8_t scale)
+{
+	int			bs, mw, mh, sw, sh, w, h, mx, my, mcux, mcuy, todo, ci, bx, by, stride;
+	_jpeg_comp	*c;
+
+	if ((_ncomp==0) || (scale>UTFT_JPEG_EIGHTH))
+		return UTFT_JPEG_FORMAT;
+	bs=8>>scale;
+	mw=_hmax*bs;
+	mh=_vmax*bs;
+	sw=getWidth(scale);
+	sh=getHeight(scale);
+	mcux=(_width+_hmax*8-1)/(_hmax*8);
+	mcuy=(_height+_vmax*8-1)/(_vmax*8);
+	todo=_restart;
+	for (ci=0; ci<_ncomp; ci++)
+	{
+		c=&_comp[ci];
+		c->bw=bs*_hmax/c->hs;
+		c->bh=bs*_vmax/c->vs;
+		c->ux=(c->bw>8) ? 1 : 0;
+		c->uy=(c->bh>8) ? 1 : 0;
+		if (c->bw>8)
+			c->bw=8;
+		if (c->bh>8)
+			c->bh=8;
+	}
+
+	for (my=0; my<mcuy; my++)
+		for (mx=0; mx<mcux; mx++)
+		{
+			if (_restart)
+			{
+				if (todo==0)
+				{
+					if (!_next_restart())
+						return UTFT_JPEG_FORMAT;
+					todo=_restart;
+				}
+				todo--;
+			}
+			for (ci=0; ci<_ncomp; ci++)
+			{
+				c=&_comp[ci];
+				stride=c->hs*c->bw;
+				for (by=0; by<c->vs; by++)
+					for (bx=0; bx<c->hs; bx++)
+					{
+						if (!_block(c) || _err)
+							return UTFT_JPEG_FORMAT;
+						_block_out(&_plane[ci][by*c->bh*stride+bx*c->bw], stride, c->bw, c->bh);
+					}
+			}
+			w=(sw-mx*mw<mw) ? sw-mx*mw : mw;
+			h=(sh-my*mh<mh) ? sh-my*mh : mh;
+			_mcu_pixels(w, h);
+			out(_io, mx*mw, my*mh, w, h, _pix);
+		}
+	return UTFT_JPEG_OK;
+}
@@ -0,0 +1,102 @@
+/*
+  UTFT_JPEG.h - small baseline JPEG decoder
+
+  Decodes baseline (Huffman, 8 bit) JPEGs, grey or YCbCr with 4:4:4, 4:2:2,
+  4:4:0 or 4:2:0 sampling, with restart markers. Data is pulled through a
+  read callback and handed out one MCU (at most 16x16 pixels, RGB565) at a
+  time, so nothing the size of the image is ever held. Decoding at 1/2,
+  1/4 or 1/8 size averages the IDCT output, or uses the DC terms only.
+  The decoder takes about 6 KB and has no dependencies on the rest of the
+  library, so it can be built and checked on a PC (extras/Tools/jpegcheck
+  compares it with libjpeg).
+
+    UTFT_JPEG	*jpg=(UTFT_JPEG *)malloc(sizeof(UTFT_JPEG));
+    if (jpg->begin(read, &io)==UTFT_JPEG_OK)
+        jpg->decode(block, UTFT_JPEG_HALF);
+*/
+
+#ifndef __UTFT_JPEG_H__
+#define __UTFT_JPEG_H__
+
+#include <stdint.h>
+
+#define UTFT_JPEG_FULL			0
+#define UTFT_JPEG_HALF			1
+#define UTFT_JPEG_QUARTER		2
+#define UTFT_JPEG_EIGHTH		3
+
+// same values as the UTFT_FILE_* codes
+#define UTFT_JPEG_OK			0
+#define UTFT_JPEG_FORMAT		-2		// not a JPEG, or damaged
+#define UTFT_JPEG_UNSUPPORTED	-5		// progressive, arithmetic coded, 12 bit or CMYK
+
+#define UTFT_JPEG_BUF			512		// input buffer, bytes
+
+// Fills buf with up to len bytes, returns how many (0 at the end)
+typedef int (*UTFT_JPEG_Read)(void *io, uint8_t *buf, int len);
+// Receives w x h pixels at (x,y) of the (scaled) image, rows packed
+typedef void (*UTFT_JPEG_Block)(void *io, int x, int y, int w, int h, const uint16_t *pix);
+
+struct _jpeg_huff
+{
+	uint16_t	fast[256];		// (length<<8)|symbol by the next 8 bits, 0 for longer codes
+	int32_t		maxcode[17];	// last code of each length, -1 if none
+	uint16_t	mincode[17];
+	uint16_t	valptr[17];		// index in val of the first code of each length
+	uint8_t		val[256];
+};
+
+struct _jpeg_comp
+{
+	uint8_t		id, hs, vs, tq, td, ta;
+	uint8_t		bw, bh;			// samples per block at the current scale
+	uint8_t		ux, uy;			// 1 where those still have to be doubled
+	int			pred;			// DC predictor
+};
+
+class UTFT_JPEG
+{
+	public:
+		int		begin(UTFT_JPEG_Read read, void *io);
+		int		decode(UTFT_JPEG_Block out, uint8_t scale=UTFT_JPEG_FULL);
+		int		getWidth(uint8_t scale=UTFT_JPEG_FULL);
+		int		getHeight(uint8_t scale=UTFT_JPEG_FULL);
+
+	private:
+		UTFT_JPEG_Read	_read;
+		void			*_io;
+		uint8_t			_buf[UTFT_JPEG_BUF];
+		int				_pos, _len;
+		uint32_t		_bits;			// entropy coded bits, MSB first
+		int				_nbits;
+		uint8_t			_marker;		// marker met inside entropy coded data
+		bool			_err;
+
+		int				_width, _height;
+		uint8_t			_ncomp, _hmax, _vmax;
+		uint16_t		_restart;
+		_jpeg_comp		_comp[3];
+		uint16_t		_quant[4][64];	// zigzag order
+		_jpeg_huff		_huff[4];		// DC 0, DC 1, AC 0, AC 1
+		int				_coef[64];		// dequantized, natural order
+		uint8_t			_plane[3][256];	// component samples of one MCU
+		uint16_t		_pix[256];
+
+		int		_byte();
+		int		_word();
+		int		_segment(int marker);
+		int		_dqt(int len);
+		int		_dht(int len);
+		int		_sof(int len);
+		int		_sos(int len);
+		void	_fill();
+		int		_getbits(int n);
+		int		_decode(const _jpeg_huff *h);
+		bool	_block(_jpeg_comp *c);
+		bool	_next_restart();
+		void	_idct(uint8_t *out);
+		void	_block_out(uint8_t *dst, int stride, int bw, int bh);
+		void	_mcu_pixels(int w, int h);
+};
+
+#endif
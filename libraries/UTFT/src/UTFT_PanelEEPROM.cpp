@@ -0,0 +1,91 @@
+/*
+  UTFT_PanelEEPROM.cpp - panel identity kept in the SPI EEPROM
+*/
+
+#include "UTFT_PanelEEPROM.h"
+
+#define EEPROM_READ			0x03
+#define EEPROM_WRITE		0x02
+#define EEPROM_WRITE_ENABLE	0x06
+#define EEPROM_READ_STATUS	0x05
+#define EEPROM_STATUS_BUSY	0x01
+
+UTFT_PanelEEPROM::UTFT_PanelEEPROM(SPIClass &spi, int cs, uint16_t addr)
+{
+	_spi=&spi;
+	_cs=cs;
+	_addr=addr;
+	_absent=false;
+}
+
+void UTFT_PanelEEPROM::begin()
+{
+	pinMode(_cs, OUTPUT);
+	digitalWrite(_cs, HIGH);
+	_spi->begin();
+	_absent=false;
+}
+
+bool UTFT_PanelEEPROM::load(uint8_t *buf, uint8_t len)
+{
+	if (_absent || !_wait_ready())
+		return false;
+	_select(EEPROM_READ);
+	_spi->transfer(_addr>>8);
+	_spi->transfer(_addr);
+	while (len--)
+		*buf++=_spi->transfer(0xFF);
+	_deselect();
+	return true;
+}
+
+// Starts the write and returns; the EEPROM finishes it on its own in a few
+// ms, and the next load() or save() waits for that.
+void UTFT_PanelEEPROM::save(const uint8_t *buf, uint8_t len)
+{
+	if (_absent || !_wait_ready())
+		return;
+	_select(EEPROM_WRITE_ENABLE);
+	_deselect();
+	_select(EEPROM_WRITE);
+	_spi->transfer(_addr>>8);
+	_spi->transfer(_addr);
+	while (len--)
+		_spi->transfer(*buf++);
+	_deselect();
+}
+
+void UTFT_PanelEEPROM::_select(uint8_t cmd)
+{
+	_spi->beginTransaction(SPISettings(UTFT_PANEL_SPEED, MSBFIRST, SPI_MODE0));
+	digitalWrite(_cs, LOW);
+	_spi->transfer(cmd);
+}
+
+void UTFT_PanelEEPROM::_deselect()
+{
+	digitalWrite(_cs, HIGH);
+	_spi->endTransaction();
+}
+
+// Polls the status register until no write is in progress. Returns false,
+// and remembers it, when there is no EEPROM: MISO idles high and reads
+// 0xFF, or the busy bit never clears.
+bool UTFT_PanelEEPROM::_wait_ready()
+{
+	unsigned long	start=millis();
+	uint8_t			st;
+
+	do
+	{
+		_select(EEPROM_READ_STATUS);
+		st=_spi->transfer(0);
+		_deselect();
+		if (st==0xFF)
+			break;
+		if (!(st & EEPROM_STATUS_BUSY))
+			return true;
+	} while (millis()-start<UTFT_PANEL_TIMEOUT);
+	_absent=true;
+	return false;
+}
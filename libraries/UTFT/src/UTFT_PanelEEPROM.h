@@ -0,0 +1,55 @@
+/*
+  UTFT_PanelEEPROM.h - panel identity kept in the SPI EEPROM
+
+  Remembers which controller answered the ID probe, the register it
+  answered on and the sum of its init table, so that later boots confirm
+  the panel with one register read instead of trying every ID register.
+  A different panel or firmware with a changed init table is probed in
+  full again. The record is UTFT_PANEL_RECORD bytes at addr (a multiple of
+  8, so it stays within one page) of a 25xx EEPROM with 16 bit addresses,
+  on EEPROM_CS and SPI2 on the MKS TFT. A status register that reads 0xFF
+  or stays busy past UTFT_PANEL_TIMEOUT means there is no EEPROM: load()
+  fails, so the panel is probed, and nothing is saved.
+
+    SPIClass SPI_2(PIN_SPI2_MOSI, PIN_SPI2_MISO, PIN_SPI2_SCK);
+    UTFT_PanelEEPROM panel(SPI_2);
+    ...
+    panel.begin();
+    myGLCD.setPanelStore(&panel);
+    myGLCD.Init();
+*/
+
+#ifndef __UTFT_PANELEEPROM_H__
+#define __UTFT_PANELEEPROM_H__
+
+#include "UTFT.h"
+#include <SPI.h>
+
+#define UTFT_PANEL_ADDR		0x0000
+#define UTFT_PANEL_SPEED	4000000
+#define UTFT_PANEL_TIMEOUT	20		// ms, 25xx write cycles take at most 5-10
+
+class UTFT_PanelEEPROM : public UTFT_PanelStore
+{
+	public:
+#ifdef EEPROM_CS
+		UTFT_PanelEEPROM(SPIClass &spi, int cs=EEPROM_CS, uint16_t addr=UTFT_PANEL_ADDR);
+#else
+		UTFT_PanelEEPROM(SPIClass &spi, int cs, uint16_t addr=UTFT_PANEL_ADDR);
+#endif
+		void	begin();
+		bool	load(uint8_t *buf, uint8_t len);
+		void	save(const uint8_t *buf, uint8_t len);
+
+	private:
+		SPIClass	*_spi;
+		int			_cs;
+		uint16_t	_addr;
+		bool		_absent;		// the status register did not answer
+
+		void		_select(uint8_t cmd);
+		void		_deselect();
+		bool		_wait_ready();
+};
+
+#endif
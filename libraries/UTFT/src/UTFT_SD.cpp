@@ -0,0 +1,379 @@
+/*
+  UTFT_SD.cpp - images streamed from the SD card
+
+  Only built when the sketch uses the SD library (#include <SD.h>).
+*/
+
+#include "UTFT.h"
+
+#if __has_include(<SD.h>)
+#include <SD.h>
+
+#define FILE_BGR24		0
+#define FILE_RGB565LE	1
+#define FILE_RGB555LE	2
+#define FILE_RGB565BE	3
+
+// Position in the pixel stream of an image file being drawn
+struct _file_image
+{
+	int			x, y, w, h;		// placement and size
+	int			tx, ty;			// next pixel in image coordinates
+	int			row;			// ty step per row, -1 for bottom-up BMP
+	byte		fmt, bpp;		// pixel format and bytes per pixel in the file
+	int			pad, skip;		// padding after each row, padding still to skip
+	uint8_t		carry[3];		// pixel split over two sectors
+	byte		ncarry;
+};
+
+static uint16_t _file_pixel(byte fmt, const uint8_t *p)
+{
+	switch (fmt)
+	{
+	case FILE_BGR24:
+		return ((p[2] & 0xF8)<<8) | ((p[1] & 0xFC)<<3) | (p[0]>>3);
+	case FILE_RGB565LE:
+		return p[0] | (p[1]<<8);
+	case FILE_RGB555LE:
+		return ((p[1] & 0x7F)<<9) | ((p[0] & 0xE0)<<1) | (p[0] & 0x1F);
+	default:
+		return (p[0]<<8) | p[1];
+	}
+}
+
+// Pushes one sector worth of pixel data. Pixels are sent in row pieces with
+// a window each, clipped to the screen and written backwards in landscape,
+// so nothing has to be held beyond the sector itself.
+static void _file_pixels(UTFT *t, _file_image *fi, const uint8_t *p, int n)
+{
+	uint16_t	px[UTFT_SD_SECTOR/2];
+	int			dispx=(t->orient==PORTRAIT) ? t->disp_x_size : t->disp_y_size;
+	int			dispy=(t->orient==PORTRAIT) ? t->disp_y_size : t->disp_x_size;
+	int			k, i, c, l, sx, sy;
+
+	while ((n>0) && (fi->ty>=0) && (fi->ty<fi->h))
+	{
+		if (fi->skip)
+		{
+			k=(n<fi->skip) ? n : fi->skip;
+			fi->skip-=k;
+			p+=k;
+			n-=k;
+			continue;
+		}
+		if (fi->ncarry)
+		{
+			while ((fi->ncarry<fi->bpp) && (n>0))
+			{
+				fi->carry[fi->ncarry++]=*p++;
+				n--;
+			}
+			if (fi->ncarry<fi->bpp)
+				return;
+			px[0]=_file_pixel(fi->fmt, fi->carry);
+			k=1;
+			fi->ncarry=0;
+		}
+		else
+		{
+			k=n/fi->bpp;
+			if (k==0)
+			{
+				while (n>0)
+				{
+					fi->carry[fi->ncarry++]=*p++;
+					n--;
+				}
+				return;
+			}
+			if (k>fi->w-fi->tx)
+				k=fi->w-fi->tx;
+			for (i=0; i<k; i++, p+=fi->bpp)
+				px[i]=_file_pixel(fi->fmt, p);
+			n-=k*fi->bpp;
+		}
+
+		c=k;
+		sx=fi->x+fi->tx;
+		sy=fi->y+fi->ty;
+		l=(sx<0) ? -sx : 0;
+		if (sx+c-1>dispx)
+			c=dispx-sx+1;
+		if ((c>l) && (sy>=0) && (sy<=dispy))
+		{
+			t->setXY(sx+l, sy, sx+c-1, sy);
+			if (t->orient!=PORTRAIT)
+				for (i=0; i<(c-l)/2; i++)
+				{
+					uint16_t s=px[l+i];
+					px[l+i]=px[c-1-i];
+					px[c-1-i]=s;
+				}
+			t->_burst_16(px+l, c-l);
+		}
+		fi->tx+=k;
+		if (fi->tx==fi->w)
+		{
+			fi->tx=0;
+			fi->ty+=fi->row;
+			fi->skip=fi->pad;
+		}
+	}
+}
+
+static uint32_t _le32(const uint8_t *p)
+{
+	return p[0] | (p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+// Draws a 16 or 24 bit BMP, a baseline JPEG at full size, or a raw RGB565
+// file (high byte first, as made by ImageConverter565) when sx gives its width. The file is read one
+// whole sector at a time, each sent to the LCD before the next is read.
+int UTFT::drawImageFromFile(const char *path, int x, int y, int sx)
+{
+	uint8_t		buf[UTFT_SD_SECTOR];
+	int			len;
+	_file_image	fi;
+	File		f;
+	uint32_t	data=0, pos;
+	int			bits;
+
+	f=SD.open(path, FILE_READ);
+	if (!f)
+		return UTFT_FILE_OPEN;
+	len=f.read(buf, UTFT_SD_SECTOR);
+
+	fi.x=x;
+	fi.y=y;
+	fi.tx=0;
+	fi.ncarry=0;
+	if ((len>=2) && (buf[0]==0xFF) && (buf[1]==0xD8))
+	{
+		f.close();
+		return drawJPEGFromFile(path, x, y);
+	}
+	if ((len>=54) && (buf[0]=='B') && (buf[1]=='M'))
+	{
+		int32_t h=(int32_t)_le32(&buf[22]);
+
+		data=_le32(&buf[10]);
+		fi.w=_le32(&buf[18]);
+		fi.h=(h<0) ? -h : h;
+		bits=buf[28] | (buf[29]<<8);
+		if (bits==24)
+			fi.fmt=FILE_BGR24;
+		else if ((bits==16) && (_le32(&buf[30])==3) && (len>=58) && (_le32(&buf[54])==0xF800))
+			fi.fmt=FILE_RGB565LE;
+		else if ((bits==16) && (_le32(&buf[30])==0))
+			fi.fmt=FILE_RGB555LE;
+		else
+		{
+			f.close();
+			return UTFT_FILE_FORMAT;
+		}
+		fi.bpp=bits/8;
+		fi.pad=(4-((fi.w*fi.bpp) & 3)) & 3;
+		fi.row=(h<0) ? 1 : -1;
+		fi.ty=(h<0) ? 0 : fi.h-1;
+	}
+	else if (sx>0)
+	{
+		fi.w=sx;
+		fi.h=f.size()/(2*sx);
+		fi.fmt=FILE_RGB565BE;
+		fi.bpp=2;
+		fi.pad=0;
+		fi.row=1;
+		fi.ty=0;
+	}
+	else
+	{
+		f.close();
+		return UTFT_FILE_FORMAT;
+	}
+
+	// start on the sector holding the first pixel
+	pos=data-(data % UTFT_SD_SECTOR);
+	if (pos)
+	{
+		f.seek(pos);
+		len=f.read(buf, UTFT_SD_SECTOR);
+	}
+	fi.skip=data-pos;
+
+	cbi(P_CS, B_CS);
+	while (len>0)
+	{
+		_file_pixels(this, &fi, buf, len);
+		len=f.read(buf, UTFT_SD_SECTOR);
+	}
+	sbi(P_CS, B_CS);
+	clrXY();
+	f.close();
+	return UTFT_FILE_OK;
+}
+
+struct _jpeg_file
+{
+	_jpeg_target	t;
+	File			*f;
+};
+
+static int _jpeg_file_read(void *io, uint8_t *buf, int len)
+{
+	return ((_jpeg_file *)io)->f->read(buf, len);
+}
+
+// Draws a baseline JPEG from the card at 1/1, 1/2, 1/4 or 1/8 size
+int UTFT::drawJPEGFromFile(const char *path, int x, int y, byte scale)
+{
+	_jpeg_file	jf;
+	File		f;
+	int			res;
+
+	f=SD.open(path, FILE_READ);
+	if (!f)
+		return UTFT_FILE_OPEN;
+	jf.t.lcd=this;
+	jf.t.x=x;
+	jf.t.y=y;
+	jf.f=&f;
+	res=_draw_jpeg(_jpeg_file_read, &jf.t, scale);
+	f.close();
+	return res;
+}
+
+// Adds a byte to the sector buffer, writing it out when it is full
+static bool _sector_put(File *f, uint8_t *sec, int *n, uint8_t b)
+{
+	sec[(*n)++]=b;
+	if (*n<UTFT_SD_SECTOR)
+		return true;
+	*n=0;
+	return f->write(sec, UTFT_SD_SECTOR)==UTFT_SD_SECTOR;
+}
+
+static void _put_le(uint8_t *p, uint32_t v, byte len)
+{
+	while (len--)
+	{
+		*p++=v;
+		v>>=8;
+	}
+}
+
+// Saves the screen as a top-down 16 bit BMP (RGB565 bitfields, which
+// drawImageFromFile() reads back). GRAM is read UTFT_SHOT_BAND rows at a
+// time and the file is written in whole sectors.
+int UTFT::saveScreenshot(const char *path)
+{
+	uint8_t		sec[UTFT_SD_SECTOR];
+	uint16_t	*band;
+	int			w=(orient==PORTRAIT) ? disp_x_size+1 : disp_y_size+1;
+	int			h=(orient==PORTRAIT) ? disp_y_size+1 : disp_x_size+1;
+	int			pad=(w*2) & 3, n=66, y, rows, i, j;
+	uint32_t	size=(uint32_t)(w*2+pad)*h;
+	bool		ok=true;
+	File		f;
+
+	band=(uint16_t *)malloc(w*UTFT_SHOT_BAND*sizeof(uint16_t));
+	if (!band)
+		return UTFT_FILE_MEMORY;
+	if (SD.exists(path))
+		SD.remove(path);
+	f=SD.open(path, FILE_WRITE);
+	if (!f)
+	{
+		free(band);
+		return UTFT_FILE_OPEN;
+	}
+
+	memset(sec, 0, n);
+	sec[0]='B';
+	sec[1]='M';
+	_put_le(&sec[2], n+size, 4);
+	_put_le(&sec[10], n, 4);
+	_put_le(&sec[14], 40, 4);
+	_put_le(&sec[18], w, 4);
+	_put_le(&sec[22], -h, 4);
+	_put_le(&sec[26], 1, 2);
+	_put_le(&sec[28], 16, 2);
+	_put_le(&sec[30], 3, 4);			// BI_BITFIELDS
+	_put_le(&sec[34], size, 4);
+	_put_le(&sec[38], 2835, 4);			// 72 dpi
+	_put_le(&sec[42], 2835, 4);
+	_put_le(&sec[54], 0xF800, 4);
+	_put_le(&sec[58], 0x07E0, 4);
+	_put_le(&sec[62], 0x001F, 4);
+
+	for (y=0; (y<h) && ok; y+=rows)
+	{
+		rows=(h-y<UTFT_SHOT_BAND) ? h-y : UTFT_SHOT_BAND;
+		readRect(0, y, w, rows, band);
+		for (j=0; j<rows; j++)
+		{
+			for (i=0; i<w; i++)
+			{
+				ok&=_sector_put(&f, sec, &n, band[j*w+i]);
+				ok&=_sector_put(&f, sec, &n, band[j*w+i]>>8);
+			}
+			for (i=0; i<pad; i++)
+				ok&=_sector_put(&f, sec, &n, 0);
+		}
+	}
+	if (ok && n)
+		ok=(f.write(sec, n)==(size_t)n);
+	f.close();
+	free(band);
+	return ok ? UTFT_FILE_OK : UTFT_FILE_WRITE;
+}
+
+// Call from loop(). A line "screenshot" on the port saves the screen to the
+// first free /SCRnnn.BMP, "screenshot <path>" to that file; the outcome is
+// sent back on the port.
+void UTFT::pollScreenshot(Stream &port)
+{
+	static char	line[UTFT_SHOT_LINE];
+	static byte	len=0;
+	char		name[]="/SCR000.BMP", *path;
+	int			c, i, res;
+
+	while ((c=port.read())>=0)
+	{
+		if ((c!='\n') && (c!='\r'))
+		{
+			if (len<UTFT_SHOT_LINE-1)
+				line[len++]=c;
+			continue;
+		}
+		line[len]=0;
+		len=0;
+		if ((strncmp(line, "screenshot", 10)!=0) || ((line[10]!=0) && (line[10]!=' ')))
+			continue;
+		for (path=line+10; *path==' '; path++);
+		if (*path==0)
+		{
+			for (i=0; i<1000; i++)
+			{
+				name[4]='0'+i/100;
+				name[5]='0'+(i/10)%10;
+				name[6]='0'+i%10;
+				if (!SD.exists(name))
+					break;
+			}
+			path=name;
+		}
+		res=saveScreenshot(path);
+		port.print("screenshot ");
+		port.print(path);
+		if (res==UTFT_FILE_OK)
+			port.println(" ok");
+		else
+		{
+			port.print(" failed ");
+			port.println((long)res);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,264 @@
+/*
+  UTFT_Sprite.cpp - moving image that puts back what it leaves uncovered
+*/
+
+#include "UTFT_Sprite.h"
+#include <stdlib.h>
+#include <string.h>
+
+UTFT_Sprite::UTFT_Sprite(UTFT *lcd, int sx, int sy, bitmapdatatype data, uint16_t key)
+{
+	_lcd=lcd;
+	_data=data;
+	_img=0;
+	_key=key;
+	_w=sx;
+	_h=sy;
+	_x=0;
+	_y=0;
+	_shown=false;
+	_bg=0;
+	_ctx=0;
+	_save=0;
+	_next=0;
+}
+
+UTFT_Sprite::UTFT_Sprite(UTFT *lcd, const uint8_t *img)
+{
+	_lcd=lcd;
+	_data=0;
+	_img=0;
+	_key=0;
+	_w=0;
+	_h=0;
+	_x=0;
+	_y=0;
+	_shown=false;
+	_bg=0;
+	_ctx=0;
+	_save=0;
+	_next=0;
+	setImage(img);
+}
+
+UTFT_Sprite::~UTFT_Sprite()
+{
+	_release();
+}
+
+// With a callback the background is produced when needed and nothing is
+// read back from the LCD. Set it while the sprite is hidden.
+void UTFT_Sprite::setBackground(UTFT_Background bg, void *ctx)
+{
+	_bg=bg;
+	_ctx=ctx;
+}
+
+// Next frame of an animation, same size as the first
+void UTFT_Sprite::setBitmap(bitmapdatatype data)
+{
+	_data=data;
+	redraw();
+}
+
+// Switches to another indexed image. A visible sprite that changes size is
+// hidden and shown again at the same place, which can fail like moveTo().
+bool UTFT_Sprite::setImage(const uint8_t *img)
+{
+	int		w, h;
+
+	if (pgm_read_byte(&img[0])!=UTFT_IMG_INDEXED)
+		return false;
+	w=pgm_read_byte(&img[2]) | (pgm_read_byte(&img[3])<<8);
+	h=pgm_read_byte(&img[4]) | (pgm_read_byte(&img[5])<<8);
+	if (_shown && ((w!=_w) || (h!=_h)))
+	{
+		hide();
+		_img=img;
+		_w=w;
+		_h=h;
+		return moveTo(_x, _y);
+	}
+	_img=img;
+	_w=w;
+	_h=h;
+	redraw();
+	return true;
+}
+
+// Shows the sprite at (x,y), or moves it there. Returns false when there is
+// no memory for the save-under buffer.
+bool UTFT_Sprite::moveTo(int x, int y)
+{
+	int		ox=_x, oy=_y, dx=x-_x, dy=y-_y, ix, iy, iw, ih, j;
+
+	if (!_shown)
+	{
+		if (!_bg)
+		{
+			_save=(uint16_t *)malloc((size_t)_w*_h*2*sizeof(uint16_t));
+			if (!_save)
+				return false;
+			_next=_save+_w*_h;
+			_lcd->readRect(x, y, _w, _h, _save);
+		}
+		_x=x;
+		_y=y;
+		_shown=true;
+		redraw();
+		return true;
+	}
+	if ((dx==0) && (dy==0))
+		return true;
+
+	iw=_w-abs(dx);
+	ih=_h-abs(dy);
+	ix=(dx>0) ? x : ox;
+	iy=(dy>0) ? y : oy;
+	if (!_bg)
+	{
+		// what is under the new position: the LCD, except where the sprite
+		// still is, which comes from the old buffer
+		_lcd->readRect(x, y, _w, _h, _next);
+		if ((iw>0) && (ih>0))
+			for (j=0; j<ih; j++)
+				memcpy(&_next[(iy-y+j)*_w+ix-x], &_save[(iy-oy+j)*_w+ix-ox], iw*sizeof(uint16_t));
+	}
+
+	cbi(_lcd->P_CS, _lcd->B_CS);
+	if ((iw<=0) || (ih<=0))
+		_rows(ox, oy, _w, _h, false);
+	else
+	{
+		if (dy>0)
+			_rows(ox, oy, _w, dy, false);
+		else if (dy<0)
+			_rows(ox, y+_h, _w, -dy, false);
+		if (dx>0)
+			_rows(ox, iy, dx, ih, false);
+		else if (dx<0)
+			_rows(x+_w, iy, -dx, ih, false);
+	}
+	if (!_bg)
+	{
+		uint16_t *s=_save;
+
+		_save=_next;
+		_next=s;
+	}
+	_x=x;
+	_y=y;
+	_rows(_x, _y, _w, _h, true);
+	sbi(_lcd->P_CS, _lcd->B_CS);
+	_lcd->clrXY();
+	return true;
+}
+
+void UTFT_Sprite::redraw()
+{
+	if (!_shown)
+		return;
+	cbi(_lcd->P_CS, _lcd->B_CS);
+	_rows(_x, _y, _w, _h, true);
+	sbi(_lcd->P_CS, _lcd->B_CS);
+	_lcd->clrXY();
+}
+
+void UTFT_Sprite::hide()
+{
+	if (!_shown)
+		return;
+	cbi(_lcd->P_CS, _lcd->B_CS);
+	_rows(_x, _y, _w, _h, false);
+	sbi(_lcd->P_CS, _lcd->B_CS);
+	_lcd->clrXY();
+	_release();
+}
+
+bool UTFT_Sprite::isVisible()
+{
+	return _shown;
+}
+
+void UTFT_Sprite::_background(int x, int y, int w, uint16_t *line)
+{
+	if (_bg)
+		_bg(_ctx, x, y, w, line);
+	else
+		memcpy(line, &_save[(y-_y)*_w+x-_x], w*sizeof(uint16_t));
+}
+
+// Sends the rows of a rectangle that are on the screen, background first
+// and, with sprite set, the sprite over it. Each row is its own window,
+// written backwards in landscape.
+void UTFT_Sprite::_rows(int x, int y, int w, int h, bool sprite)
+{
+	uint16_t	line[UTFT_SCALE_LINE];
+	int			dispx=(_lcd->orient==PORTRAIT) ? _lcd->disp_x_size : _lcd->disp_y_size;
+	int			dispy=(_lcd->orient==PORTRAIT) ? _lcd->disp_y_size : _lcd->disp_x_size;
+	int			x1=0, x2=w-1, n, i, j, u, stride=0;
+	uint16_t	c;
+	byte		bpp=0, flags=0;
+	const uint8_t	*row=0;
+
+	if (x<0)
+		x1=-x;
+	if (x+x2>dispx)
+		x2=dispx-x;
+	if (x2-x1>=UTFT_SCALE_LINE)
+		x2=x1+UTFT_SCALE_LINE-1;
+	n=x2-x1+1;
+	if (n<=0)
+		return;
+	if (sprite && _img)
+	{
+		bpp=pgm_read_byte(&_img[1]);
+		flags=pgm_read_byte(&_img[7]);
+		stride=(_w*bpp+7)/8;
+		row=_img+UTFT_IMG_HDR+(pgm_read_byte(&_img[6])+1)*2;
+	}
+
+	for (j=0; j<h; j++)
+	{
+		if ((y+j<0) || (y+j>dispy))
+			continue;
+		_background(x+x1, y+j, n, line);
+		if (sprite)
+			for (i=0; i<n; i++)
+			{
+				u=x1+i;
+				if (_img)
+				{
+					const uint8_t *p=row+j*stride;
+
+					c=((pgm_read_byte(&p[(u*bpp)>>3])<<((u*bpp)&7)) & 0xFF)>>(8-bpp);
+					if ((c==0) && (flags & UTFT_IMG_TRANSPARENT))
+						continue;
+					line[i]=pgm_read_byte(&_img[UTFT_IMG_HDR+c*2]) | (pgm_read_byte(&_img[UTFT_IMG_HDR+c*2+1])<<8);
+				}
+				else
+				{
+					c=pgm_read_word(&_data[j*_w+u]);
+					if (c!=_key)
+						line[i]=c;
+				}
+			}
+		if (_lcd->orient!=PORTRAIT)
+			for (i=0; i<n/2; i++)
+			{
+				c=line[i];
+				line[i]=line[n-1-i];
+				line[n-1-i]=c;
+			}
+		_lcd->setXY(x+x1, y+j, x+x2, y+j);
+		_lcd->_burst_16(line, n);
+	}
+}
+
+void UTFT_Sprite::_release()
+{
+	free(_save);
+	_save=0;
+	_next=0;
+	_shown=false;
+}
@@ -0,0 +1,62 @@
+/*
+  UTFT_Sprite.h - moving image that puts back what it leaves uncovered
+
+  A sprite is an RGB565 bitmap with a key colour, or an indexed image made
+  by imgpack, where palette entry 0 is the key if the image was packed with
+  a transparent colour. Key pixels show the background. When the sprite
+  moves, only the strips of the old position that the new one does not
+  cover are restored, and the new position is drawn row by row with the
+  background already mixed in, so nothing flickers.
+
+  The background comes from a callback that can produce any row of it (a
+  gradient, a tile map, an image in flash) or, without one, from the LCD:
+  the area under the sprite is read back before it is drawn over and kept
+  in a buffer of twice the sprite size.
+
+    UTFT_Sprite cursor(&myGLCD, 16, 16, arrow, FUCHSIA);
+    cursor.moveTo(tx, ty);
+    ...
+    cursor.hide();
+*/
+
+#ifndef __UTFT_SPRITE_H__
+#define __UTFT_SPRITE_H__
+
+#include "UTFT.h"
+
+// Fills line with w background pixels of screen row y, starting at x
+typedef void (*UTFT_Background)(void *ctx, int x, int y, int w, uint16_t *line);
+
+class UTFT_Sprite
+{
+	public:
+		UTFT_Sprite(UTFT *lcd, int sx, int sy, bitmapdatatype data, uint16_t key);
+		UTFT_Sprite(UTFT *lcd, const uint8_t *img);
+		~UTFT_Sprite();
+
+		void	setBackground(UTFT_Background bg, void *ctx);
+		void	setBitmap(bitmapdatatype data);
+		bool	setImage(const uint8_t *img);
+		bool	moveTo(int x, int y);
+		void	redraw();
+		void	hide();
+		bool	isVisible();
+
+	private:
+		UTFT				*_lcd;
+		bitmapdatatype		_data;
+		const uint8_t		*_img;
+		uint16_t			_key;
+		int					_w, _h;
+		int					_x, _y;
+		bool				_shown;
+		UTFT_Background		_bg;
+		void				*_ctx;
+		uint16_t			*_save, *_next;		// background under the sprite, and under the next position
+
+		void	_background(int x, int y, int w, uint16_t *line);
+		void	_rows(int x, int y, int w, int h, bool sprite);
+		void	_release();
+};
+
+#endif
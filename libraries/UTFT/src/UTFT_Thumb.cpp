@@ -0,0 +1,782 @@
+/*
+  UTFT_Thumb.cpp - preview images embedded in G-code files
+
+  Slicers store thumbnails as base64 comment blocks near the top of the file:
+
+    ; thumbnail begin 220x124 10452			(PNG)
+    ; thumbnail_QOI begin 220x124 8712		(QOI)
+    ; thumbnail_JPG begin 220x124 6904		(JPEG)
+    ; iVBORw0KGgoAAAANSUhEUgAAANwAAAB8...
+    ; thumbnail end
+
+  The block is decoded straight from the file one row at a time: base64,
+  then the PNG chunks and zlib stream (8 bit grey/RGB/alpha, not interlaced)
+  or the QOI ops, then scaled to fit and pushed to the LCD. Only the inflate
+  window and two rows are allocated while a PNG is drawn. JPEGs go through
+  UTFT_JPEG, shrunk by the largest of its 1/2..1/8 steps that still fits.
+
+  Only built when the sketch uses the SD library (#include <SD.h>).
+*/
+
+#include "UTFT.h"
+
+#if __has_include(<SD.h>)
+#include <SD.h>
+
+#define THUMB_PNG		0
+#define THUMB_QOI		1
+#define THUMB_JPG		2
+#define THUMB_MAX		4		// thumbnail blocks remembered while scanning
+
+struct _thumb_block
+{
+	uint32_t	pos;			// file offset of the first base64 line
+	int32_t		len;			// base64 characters
+	int			w, h;
+	byte		fmt;
+};
+
+// Decoder state: the file, the base64 stream, the inflater and the row
+// being built, plus where the rows go on the screen.
+struct _thumb
+{
+	UTFT		*lcd;
+	File		*f;
+	uint8_t		buf[UTFT_SD_SECTOR];
+	int			pos, len;
+	uint32_t	base;			// file offset of buf[0]
+	int32_t		left;			// base64 characters left in the block
+	uint32_t	acc;			// base64 bits not yet returned
+	int			nacc;
+	bool		err;
+
+	uint32_t	chunk;			// PNG: IDAT bytes left in the current chunk
+	bool		idat;
+	uint32_t	bitbuf;			// inflate bit buffer, LSB first
+	int			bitcnt;
+	uint8_t		*win;			// inflate window, power of two
+	uint32_t	mask, out;
+	uint8_t		*cur, *prev;	// filtered rows, filter byte first
+	int			stride, rpos, bpp;
+	byte		ctype;
+
+	int			w, h;			// image size
+	int			x, y, dw, dh;	// where it goes
+	int			ty, next;		// source row being built, next screen row
+	uint16_t	*row;			// source row, RGB565
+	int			br, bg, bb;		// background for alpha
+	uint16_t	line[UTFT_SCALE_LINE];
+};
+
+struct _huff
+{
+	short	*count;				// codes per length
+	short	*symbol;			// symbols in canonical order
+};
+
+static const short _len_base[29]={3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+static const byte _len_extra[29]={0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+static const short _dist_base[30]={1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+static const byte _dist_extra[30]={0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+static const byte _clen_order[19]={16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15};
+
+static void _thumb_seek(_thumb *t, uint32_t pos)
+{
+	t->f->seek(pos);
+	t->base=pos;
+	t->pos=t->len=0;
+}
+
+static int _thumb_getc(_thumb *t)
+{
+	if (t->pos==t->len)
+	{
+		t->base+=t->len;
+		t->pos=0;
+		t->len=t->f->read(t->buf, UTFT_SD_SECTOR);
+		if (t->len<=0)
+		{
+			t->len=0;
+			return -1;
+		}
+	}
+	return t->buf[t->pos++];
+}
+
+static int _b64_value(int c)
+{
+	if ((c>='A') && (c<='Z'))
+		return c-'A';
+	if ((c>='a') && (c<='z'))
+		return c-'a'+26;
+	if ((c>='0') && (c<='9'))
+		return c-'0'+52;
+	if (c=='+')
+		return 62;
+	if (c=='/')
+		return 63;
+	if (c=='=')
+		return 64;
+	return -1;
+}
+
+// Next decoded byte of the block, -1 at its end. The "; " line prefixes and
+// line ends are not part of the base64 text and are skipped.
+static int _thumb_byte(_thumb *t)
+{
+	int c, v;
+
+	while (t->nacc<8)
+	{
+		if (t->left<=0)
+		{
+			t->err=true;
+			return -1;
+		}
+		c=_thumb_getc(t);
+		if (c<0)
+		{
+			t->err=true;
+			return -1;
+		}
+		v=_b64_value(c);
+		if (v<0)
+			continue;
+		t->left--;
+		if (v<64)
+		{
+			t->acc=(t->acc<<6) | v;
+			t->nacc+=6;
+		}
+	}
+	t->nacc-=8;
+	return (t->acc>>t->nacc) & 0xFF;
+}
+
+static uint32_t _thumb_be32(_thumb *t)
+{
+	uint32_t v=0;
+
+	for (int i=0; i<4; i++)
+		v=(v<<8) | (_thumb_byte(t) & 0xFF);
+	return v;
+}
+
+static uint16_t _thumb_rgb(_thumb *t, int r, int g, int b, int a)
+{
+	if (a<255)
+	{
+		r=(r*a+t->br*(255-a))/255;
+		g=(g*a+t->bg*(255-a))/255;
+		b=(b*a+t->bb*(255-a))/255;
+	}
+	return ((r & 0xF8)<<8) | ((g & 0xFC)<<3) | (b>>3);
+}
+
+// The source row in t->row is done: draws it on every screen row that maps
+// to it (none when shrinking past it, several when enlarging).
+static void _thumb_emit(_thumb *t)
+{
+	int i, rows=0;
+
+	while ((t->next+rows<t->dh) && ((long)(t->next+rows)*t->h/t->dh==t->ty))
+		rows++;
+	if (rows)
+	{
+		for (i=0; i<t->dw; i++)
+			t->line[(t->lcd->orient==PORTRAIT) ? i : t->dw-1-i]=t->row[(long)i*t->w/t->dw];
+		t->lcd->_push_rows(t->x, t->y+t->next, t->dw, rows, t->line);
+		t->next+=rows;
+	}
+	t->ty++;
+}
+
+/****************************** QOI ******************************/
+
+static int _qoi_decode(_thumb *t)
+{
+	uint8_t		index[64][4];
+	uint8_t		px[4]={0, 0, 0, 255};
+	int			tx, op, run=0, d;
+
+	if (_thumb_be32(t)!=0x716F6966)			// "qoif"
+		return UTFT_FILE_FORMAT;
+	t->w=_thumb_be32(t);
+	t->h=_thumb_be32(t);
+	_thumb_byte(t);							// channels and colour space do not
+	_thumb_byte(t);							// change how the ops decode
+	if (t->err || (t->w<=0) || (t->h<=0))
+		return UTFT_FILE_FORMAT;
+	t->row=(uint16_t *)malloc(t->w*2);
+	if (!t->row)
+		return UTFT_FILE_MEMORY;
+	memset(index, 0, sizeof(index));
+
+	while ((t->ty<t->h) && !t->err)
+	{
+		for (tx=0; tx<t->w; tx++)
+		{
+			if (run)
+				run--;
+			else
+			{
+				op=_thumb_byte(t);
+				if (op==0xFE || op==0xFF)
+				{
+					px[0]=_thumb_byte(t);
+					px[1]=_thumb_byte(t);
+					px[2]=_thumb_byte(t);
+					if (op==0xFF)
+						px[3]=_thumb_byte(t);
+				}
+				else if ((op>>6)==0)
+					memcpy(px, index[op], 4);
+				else if ((op>>6)==1)
+				{
+					px[0]+=((op>>4) & 3)-2;
+					px[1]+=((op>>2) & 3)-2;
+					px[2]+=(op & 3)-2;
+				}
+				else if ((op>>6)==2)
+				{
+					d=(op & 0x3F)-32;
+					op=_thumb_byte(t);
+					px[0]+=d-8+((op>>4) & 0x0F);
+					px[1]+=d;
+					px[2]+=d-8+(op & 0x0F);
+				}
+				else
+					run=op & 0x3F;
+				memcpy(index[(px[0]*3+px[1]*5+px[2]*7+px[3]*11) & 63], px, 4);
+			}
+			t->row[tx]=_thumb_rgb(t, px[0], px[1], px[2], px[3]);
+		}
+		_thumb_emit(t);
+	}
+	free(t->row);
+	return (t->ty==t->h) ? UTFT_FILE_OK : UTFT_FILE_FORMAT;
+}
+
+/****************************** PNG ******************************/
+
+// Next byte of zlib data, walking over the chunks between IDATs
+static int _png_byte(_thumb *t)
+{
+	uint32_t len, type;
+
+	while (t->chunk==0)
+	{
+		if (t->idat)
+			_thumb_be32(t);					// CRC
+		len=_thumb_be32(t);
+		type=_thumb_be32(t);
+		if (t->err || (type==0x49454E44))	// IEND
+		{
+			t->err=true;
+			return -1;
+		}
+		t->idat=(type==0x49444154);			// IDAT
+		if (t->idat)
+			t->chunk=len;
+		else
+			for (len+=4; (len>0) && !t->err; len--)
+				_thumb_byte(t);
+	}
+	t->chunk--;
+	return _thumb_byte(t);
+}
+
+static int _inf_bits(_thumb *t, int need)
+{
+	uint32_t	val=t->bitbuf;
+	int			c;
+
+	while (t->bitcnt<need)
+	{
+		c=_png_byte(t);
+		if (c<0)
+			return 0;
+		val|=(uint32_t)c<<t->bitcnt;
+		t->bitcnt+=8;
+	}
+	t->bitbuf=val>>need;
+	t->bitcnt-=need;
+	return val & ((1L<<need)-1);
+}
+
+// Undoes the row filter, converts the row to RGB565 and draws it. Filter
+// types past 4 mark the stream as damaged.
+static void _png_row(_thumb *t)
+{
+	uint8_t		*c=t->cur, *p=t->prev, *tmp;
+	int			i, a, b, d, pa, pb, pc, bpp=t->bpp;
+
+	if (c[0]>4)
+	{
+		t->err=true;
+		return;
+	}
+	for (i=1; i<t->stride; i++)
+	{
+		a=(i>bpp) ? c[i-bpp] : 0;
+		b=p[i];
+		d=(i>bpp) ? p[i-bpp] : 0;
+		switch (c[0])
+		{
+		case 1:
+			c[i]+=a;
+			break;
+		case 2:
+			c[i]+=b;
+			break;
+		case 3:
+			c[i]+=(a+b)>>1;
+			break;
+		case 4:
+			pa=abs(b-d);
+			pb=abs(a-d);
+			pc=abs(a+b-2*d);
+			c[i]+=((pa<=pb) && (pa<=pc)) ? a : (pb<=pc) ? b : d;
+			break;
+		}
+	}
+	for (i=0, c=t->cur+1; i<t->w; i++, c+=bpp)
+		switch (t->ctype)
+		{
+		case 0:
+			t->row[i]=_thumb_rgb(t, c[0], c[0], c[0], 255);
+			break;
+		case 2:
+			t->row[i]=_thumb_rgb(t, c[0], c[1], c[2], 255);
+			break;
+		case 4:
+			t->row[i]=_thumb_rgb(t, c[0], c[0], c[0], c[1]);
+			break;
+		default:
+			t->row[i]=_thumb_rgb(t, c[0], c[1], c[2], c[3]);
+		}
+	_thumb_emit(t);
+	tmp=t->prev;
+	t->prev=t->cur;
+	t->cur=tmp;
+	t->rpos=0;
+}
+
+static void _inf_put(_thumb *t, uint8_t v)
+{
+	t->win[t->out++ & t->mask]=v;
+	if (t->ty<t->h)
+	{
+		t->cur[t->rpos++]=v;
+		if (t->rpos==t->stride)
+			_png_row(t);
+	}
+}
+
+// Canonical Huffman decoding as in zlib's puff.c: codes of one length are
+// consecutive, so a code is found by counting, without lookup tables.
+static int _inf_build(_huff *h, const short *length, int n)
+{
+	short	offs[16];
+	int		len, sym, left=1;
+
+	for (len=0; len<16; len++)
+		h->count[len]=0;
+	for (sym=0; sym<n; sym++)
+		h->count[length[sym]]++;
+	if (h->count[0]==n)
+		return 0;
+	for (len=1; len<16; len++)
+	{
+		left<<=1;
+		left-=h->count[len];
+		if (left<0)
+			return -1;
+	}
+	offs[1]=0;
+	for (len=1; len<15; len++)
+		offs[len+1]=offs[len]+h->count[len];
+	for (sym=0; sym<n; sym++)
+		if (length[sym])
+			h->symbol[offs[length[sym]]++]=sym;
+	return left;
+}
+
+static int _inf_decode(_thumb *t, const _huff *h)
+{
+	int len, code=0, first=0, index=0, count;
+
+	for (len=1; len<16; len++)
+	{
+		code|=_inf_bits(t, 1);
+		count=h->count[len];
+		if (code-count<first)
+			return h->symbol[index+(code-first)];
+		index+=count;
+		first+=count;
+		first<<=1;
+		code<<=1;
+	}
+	return -1;
+}
+
+static bool _inf_codes(_thumb *t, const _huff *lencode, const _huff *distcode)
+{
+	int			sym, len;
+	uint32_t	dist;
+
+	do
+	{
+		sym=_inf_decode(t, lencode);
+		if ((sym<0) || t->err)
+			return false;
+		if (sym<256)
+			_inf_put(t, sym);
+		else if (sym>256)
+		{
+			sym-=257;
+			if (sym>=29)
+				return false;
+			len=_len_base[sym]+_inf_bits(t, _len_extra[sym]);
+			sym=_inf_decode(t, distcode);
+			if ((sym<0) || (sym>=30))
+				return false;
+			dist=_dist_base[sym]+_inf_bits(t, _dist_extra[sym]);
+			if ((dist>t->out) || (dist>t->mask+1))
+				return false;				// beyond what the window holds
+			while (len--)
+				_inf_put(t, t->win[(t->out-dist) & t->mask]);
+		}
+	} while ((sym!=256) && (t->ty<t->h));
+	return true;
+}
+
+static bool _inf_stored(_thumb *t)
+{
+	int len;
+
+	t->bitbuf=0;
+	t->bitcnt=0;
+	len=_png_byte(t);
+	len|=_png_byte(t)<<8;
+	if ((_png_byte(t) | (_png_byte(t)<<8))!=(~len & 0xFFFF))
+		return false;
+	while (len-- && !t->err)
+		_inf_put(t, _png_byte(t));
+	return !t->err;
+}
+
+static bool _inf_fixed(_thumb *t)
+{
+	short	lencnt[16], lensym[288], distcnt[16], distsym[30], lengths[288];
+	_huff	lencode={lencnt, lensym}, distcode={distcnt, distsym};
+	int		sym;
+
+	for (sym=0; sym<288; sym++)
+		lengths[sym]=(sym<144) ? 8 : (sym<256) ? 9 : (sym<280) ? 7 : 8;
+	_inf_build(&lencode, lengths, 288);
+	for (sym=0; sym<30; sym++)
+		lengths[sym]=5;
+	_inf_build(&distcode, lengths, 30);
+	return _inf_codes(t, &lencode, &distcode);
+}
+
+static bool _inf_dynamic(_thumb *t)
+{
+	short	lencnt[16], lensym[286], distcnt[16], distsym[30], lengths[316];
+	_huff	lencode={lencnt, lensym}, distcode={distcnt, distsym};
+	int		nlen, ndist, ncode, index, sym, len, rep, err;
+
+	nlen=_inf_bits(t, 5)+257;
+	ndist=_inf_bits(t, 5)+1;
+	ncode=_inf_bits(t, 4)+4;
+	if ((nlen>286) || (ndist>30))
+		return false;
+	for (index=0; index<19; index++)
+		lengths[_clen_order[index]]=(index<ncode) ? _inf_bits(t, 3) : 0;
+	if (_inf_build(&lencode, lengths, 19)!=0)
+		return false;
+
+	for (index=0; index<nlen+ndist; )
+	{
+		sym=_inf_decode(t, &lencode);
+		if ((sym<0) || t->err)
+			return false;
+		if (sym<16)
+			lengths[index++]=sym;
+		else
+		{
+			len=0;
+			if (sym==16)
+			{
+				if (index==0)
+					return false;
+				len=lengths[index-1];
+				rep=3+_inf_bits(t, 2);
+			}
+			else if (sym==17)
+				rep=3+_inf_bits(t, 3);
+			else
+				rep=11+_inf_bits(t, 7);
+			if (index+rep>nlen+ndist)
+				return false;
+			while (rep--)
+				lengths[index++]=len;
+		}
+	}
+	if (lengths[256]==0)
+		return false;
+	err=_inf_build(&lencode, lengths, nlen);
+	if ((err<0) || ((err>0) && (nlen-lencode.count[0]!=1)))
+		return false;
+	err=_inf_build(&distcode, lengths+nlen, ndist);
+	if ((err<0) || ((err>0) && (ndist-distcode.count[0]!=1)))
+		return false;
+	return _inf_codes(t, &lencode, &distcode);
+}
+
+static int _png_decode(_thumb *t)
+{
+	static const uint8_t	sig[8]={0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	uint32_t				need, size;
+	int						i, cmf, flg, depth, last, type;
+	bool					ok=true;
+	uint8_t					*mem;
+
+	for (i=0; i<8; i++)
+		if (_thumb_byte(t)!=sig[i])
+			return UTFT_FILE_FORMAT;
+	if ((_thumb_be32(t)!=13) || (_thumb_be32(t)!=0x49484452))		// IHDR
+		return UTFT_FILE_FORMAT;
+	t->w=_thumb_be32(t);
+	t->h=_thumb_be32(t);
+	depth=_thumb_byte(t);
+	t->ctype=_thumb_byte(t);
+	_thumb_byte(t);
+	_thumb_byte(t);
+	if ((_thumb_byte(t)!=0) || (depth!=8) || (t->w<=0) || (t->h<=0) || t->err)	// interlaced
+		return UTFT_FILE_FORMAT;
+	_thumb_be32(t);													// CRC
+	switch (t->ctype)
+	{
+	case 0:
+		t->bpp=1;
+		break;
+	case 2:
+		t->bpp=3;
+		break;
+	case 4:
+		t->bpp=2;
+		break;
+	case 6:
+		t->bpp=4;
+		break;
+	default:
+		return UTFT_FILE_FORMAT;									// palette
+	}
+	t->stride=t->w*t->bpp+1;
+
+	cmf=_png_byte(t);
+	flg=_png_byte(t);
+	if (t->err || ((cmf & 0x0F)!=8) || (((cmf<<8) | flg) % 31) || (flg & 0x20))
+		return UTFT_FILE_FORMAT;
+	// The window never needs to be larger than the image itself. A smaller
+	// one than the stream declares would turn long matches into garbage.
+	need=1L<<((cmf>>4)+8);
+	if (need>(uint32_t)t->stride*t->h)
+		need=(uint32_t)t->stride*t->h;
+	if (need>UTFT_THUMB_WINDOW)
+		return UTFT_FILE_MEMORY;
+	for (size=256; size<need; size<<=1)
+		;
+	mem=(uint8_t *)malloc(size+((t->stride*2+1) & ~1)+t->w*2);
+	if (!mem)
+		return UTFT_FILE_MEMORY;
+	t->win=mem;
+	t->mask=size-1;
+	t->cur=mem+size;
+	t->prev=t->cur+t->stride;
+	t->row=(uint16_t *)(t->cur+((t->stride*2+1) & ~1));
+	memset(t->prev, 0, t->stride);
+
+	do
+	{
+		last=_inf_bits(t, 1);
+		type=_inf_bits(t, 2);
+		if (type==0)
+			ok=_inf_stored(t);
+		else if (type==1)
+			ok=_inf_fixed(t);
+		else if (type==2)
+			ok=_inf_dynamic(t);
+		else
+			ok=false;
+	} while (ok && !last && !t->err && (t->ty<t->h));
+	free(mem);
+	return (t->ty==t->h) ? UTFT_FILE_OK : UTFT_FILE_FORMAT;
+}
+
+/****************************** JPEG *****************************/
+
+struct _thumb_jpeg
+{
+	_jpeg_target	t;
+	_thumb			*th;
+};
+
+static int _thumb_jpeg_read(void *io, uint8_t *buf, int len)
+{
+	_thumb	*t=((_thumb_jpeg *)io)->th;
+	int		i, c;
+
+	for (i=0; (i<len) && ((c=_thumb_byte(t))>=0); i++)
+		buf[i]=c;
+	return i;
+}
+
+/**************************** G-code *****************************/
+
+static int _thumb_num(const char **p)
+{
+	int v=0;
+
+	while ((**p>='0') && (**p<='9'))
+		v=v*10+*(*p)++-'0';
+	return v;
+}
+
+// Looks through the comment header for thumbnail blocks, stopping at the
+// first G-code line
+static int _thumb_scan(_thumb *t, _thumb_block *blk)
+{
+	char		line[48];
+	const char	*p;
+	int			c, n, found=0;
+
+	while (t->base+t->pos<UTFT_THUMB_SCAN)
+	{
+		for (n=0; ((c=_thumb_getc(t))>=0) && (c!='\n'); )
+			if (n<(int)sizeof(line)-1)
+				line[n++]=c;
+		line[n]=0;
+		if ((c<0) && (n==0))
+			break;
+		if (n && (line[0]!=';') && (line[0]!='\r') && (line[0]!=' '))
+			break;
+		if (strncmp(line, "; thumbnail", 11) || (found==THUMB_MAX))
+			continue;
+		p=line+11;
+		blk[found].fmt=THUMB_PNG;
+		if (!strncmp(p, "_QOI", 4))
+		{
+			blk[found].fmt=THUMB_QOI;
+			p+=4;
+		}
+		else if (!strncmp(p, "_JPG", 4))
+		{
+			blk[found].fmt=THUMB_JPG;
+			p+=4;
+		}
+		else if (!strncmp(p, "_PNG", 4))
+			p+=4;
+		if (strncmp(p, " begin ", 7))
+			continue;
+		p+=7;
+		blk[found].w=_thumb_num(&p);
+		if (*p++!='x')
+			continue;
+		blk[found].h=_thumb_num(&p);
+		if (*p++!=' ')
+			continue;
+		blk[found].len=_thumb_num(&p);
+		blk[found].pos=t->base+t->pos;
+		if (blk[found].w && blk[found].h && blk[found].len)
+			found++;
+	}
+	return found;
+}
+
+// Draws the thumbnail of a G-code file scaled to fit w x h, centered (JPEGs
+// are only ever shrunk, in halving steps). Of
+// several thumbnails the largest one that fits unscaled is used, otherwise
+// the smallest one is shrunk. Transparent pixels take the back colour.
+int UTFT::drawThumbnail(const char *path, int x, int y, int w, int h)
+{
+	File			f;
+	_thumb			t;
+	_thumb_block	blk[THUMB_MAX];
+	int				i, n, best=-1, res, fw;
+
+	f=SD.open(path, FILE_READ);
+	if (!f)
+		return UTFT_FILE_OPEN;
+	memset(&t, 0, sizeof(t));
+	t.lcd=this;
+	t.f=&f;
+	n=_thumb_scan(&t, blk);
+	for (i=0; i<n; i++)
+		if ((blk[i].w<=w) && (blk[i].h<=h) && ((best<0) || (blk[i].w*blk[i].h>blk[best].w*blk[best].h)))
+			best=i;
+	if (best<0)
+		for (i=0; i<n; i++)
+			if ((best<0) || (blk[i].w*blk[i].h<blk[best].w*blk[best].h))
+				best=i;
+	if (best<0)
+	{
+		f.close();
+		return UTFT_FILE_NONE;
+	}
+
+	// fit the advertised size into the box (rows are at most UTFT_SCALE_LINE
+	// wide), keeping the aspect ratio, and centre it in the whole box
+	fw=(w>UTFT_SCALE_LINE) ? UTFT_SCALE_LINE : w;
+	if ((long)blk[best].w*h>(long)blk[best].h*fw)
+	{
+		t.dw=fw;
+		t.dh=(long)blk[best].h*fw/blk[best].w;
+	}
+	else
+	{
+		t.dh=h;
+		t.dw=(long)blk[best].w*h/blk[best].h;
+	}
+	if (t.dw<1)
+		t.dw=1;
+	if (t.dh<1)
+		t.dh=1;
+	t.x=x+(w-t.dw)/2;
+	t.y=y+(h-t.dh)/2;
+	t.br=bch & 0xF8;
+	t.bg=((bch<<5) | (bcl>>3)) & 0xFC;
+	t.bb=(bcl<<3) & 0xF8;
+	t.left=blk[best].len;
+	_thumb_seek(&t, blk[best].pos);
+
+	if (blk[best].fmt==THUMB_JPG)
+	{
+		_thumb_jpeg	tj;
+		byte		scale=UTFT_JPEG_FULL;
+
+		while ((scale<UTFT_JPEG_EIGHTH) && ((blk[best].w>>scale>w) || (blk[best].h>>scale>h)))
+			scale++;
+		tj.t.lcd=this;
+		tj.t.x=x+(w-((blk[best].w+(1<<scale)-1)>>scale))/2;
+		tj.t.y=y+(h-((blk[best].h+(1<<scale)-1)>>scale))/2;
+		tj.th=&t;
+		res=_draw_jpeg(_thumb_jpeg_read, &tj.t, scale);
+		f.close();
+		return res;
+	}
+
+	cbi(P_CS, B_CS);
+	if (blk[best].fmt==THUMB_QOI)
+		res=_qoi_decode(&t);
+	else
+		res=_png_decode(&t);
+	sbi(P_CS, B_CS);
+	clrXY();
+	f.close();
+	return res;
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include "User_delay.h"
 
 // 不精确，用于软件中延时；
 #if defined(STM32GENERIC)||defined(ARDUINO_ARCH_MAPLE_STM32F1)||\
@@ -15,17 +16,35 @@
 #endif
 
 
+#ifdef DWT
+void USER_delay_us(uint32_t us)
+{
+  USER_delay_cycles(us * (F_CPU / 1000000));
+}
+#else
+// no cycle counter on this core: a loop of about 10 cycles a turn
 void USER_delay_us(uint32_t us)
 {
   volatile uint32_t nCount =us*USER_DELAY_MUL;	
   for(; nCount != 0; nCount--);
 }
 
+void USER_delay_cycles(uint32_t n)
+{
+  volatile uint32_t nCount = n / 10;
+  for(; nCount != 0; nCount--);
+}
+#endif
+
 void USER_delay_ms(uint32_t ms)
 {
   volatile uint32_t nCount = ms;	
   for(; nCount != 0; nCount--){
-	  USER_delay_us(935);
+#ifdef DWT
+	  USER_delay_us(1000);
+#else
+	  USER_delay_us(935);	// the countdown runs long, calibrated to 1 ms
+#endif
   }
 }
 
@@ -29,6 +29,8 @@
 #ifndef __USER_DELAY_H__
 #define __USER_DELAY_H__
 
+#include <Arduino.h>
+
 #ifdef __cplusplus
  extern "C" {
 #endif /* __cplusplus */ 					  
@@ -36,6 +38,32 @@
 extern void USER_delay_us(uint32_t us);
 extern void USER_delay_ms(uint32_t ms);
 
+#ifdef DWT
+// Waits n CPU cycles on the DWT cycle counter, so the wait does not depend on
+// the compiler flags or flash wait states. The counter is started on first use.
+static inline void USER_delay_cycles(uint32_t n)
+{
+	uint32_t	t;
+
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+	t = DWT->CYCCNT;
+	while ((uint32_t)(DWT->CYCCNT - t) < n);
+}
+#else
+extern void USER_delay_cycles(uint32_t n);
+#endif
+
+// At least ns nanoseconds, rounded up to whole cycles (ns < 59 s at 72 MHz)
+static inline void USER_delay_ns(uint32_t ns)
+{
+	USER_delay_cycles((ns * (F_CPU / 1000000) + 999) / 1000);
+}
+
 #ifdef __cplusplus
 } // extern "C" {
 #endif /* __cplusplus */ 					  
@@ -6,11 +6,26 @@
   #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
 
-typedef struct
+#include "HW_STM32F_bus.h"
+
+// Bus timing profiles, fastest first: slew rate of the GPIOE data lines and
+// NOPs around the nWR edges. Different batches of the same controller take
+// different timings, tuneBus() picks one that reads back cleanly. With nWR
+// strobed on the port registers the padding sets the pace; the default comes
+// close to the edges of the old HAL calls.
+static const struct
 {
-	volatile uint16_t  REG;
-	volatile uint16_t  RAM;
-} LCD_IO_TypeDef;
+	uint32_t	speed;
+	byte		pad;
+} _bus_profiles[UTFT_BUS_PROFILES] = {
+	{GPIO_SPEED_FREQ_HIGH,		0},
+	{GPIO_SPEED_FREQ_MEDIUM,	0},
+	{GPIO_SPEED_FREQ_MEDIUM,	4},
+	{GPIO_SPEED_FREQ_LOW,		8},		// UTFT_BUS_DEFAULT
+	{GPIO_SPEED_FREQ_LOW,		16},
+};
+
+static uint32_t _bus_speed=GPIO_SPEED_FREQ_LOW;		// set_register() has no UTFT to ask
 
 
 
@@ -19,8 +34,6 @@ typedef struct
 #if __has_include("bsp.h")
 #  include "bsp.h"
 #endif
-#define TFT_LCD_BASE 0x40011800
-#define   TFT_LCD             ((LCD_IO_TypeDef *) TFT_LCD_BASE)
 	#if defined(STM32F107xC)
 
 	#define sbi(reg, bitmask) *reg |= bitmask
@@ -45,7 +58,7 @@ void UTFT::_hw_special_init(void)
   GPIO_InitStruct.Pin = 0xffff;
   GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
  // GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  GPIO_InitStruct.Speed = _bus_speed;
   HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
   pinMode(LCD_BACKLIGHT_PIN,OUTPUT); 
   digitalWrite(LCD_BACKLIGHT_PIN,LOW);
@@ -91,7 +104,9 @@ void UTFT::LCD_Writ_Bus(int VH,int VL, byte mode)
 	if (VH==0) 
 	{
 		GPIOE->ODR = (uint16_t)VL;
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
 	}
 	else
@@ -99,10 +114,14 @@ void UTFT::LCD_Writ_Bus(int VH,int VL, byte mode)
 
 		
 		GPIOE->ODR=(uint16_t)VH;
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
 		GPIOE->ODR=(uint16_t)VL;
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		_bus_wait(_bus_pad);
 		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
 	}
 #else
@@ -125,7 +144,7 @@ void UTFT::_set_direction_registers(byte mode)
         HAL_GPIO_WritePin(GPIOE, 0xffff, GPIO_PIN_RESET);
         GPIO_InitStruct.Pin = 0xffff;
         GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+        GPIO_InitStruct.Speed = _bus_speed;
 		HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
   break;
   case 1:
@@ -139,15 +158,32 @@ void UTFT::_set_direction_registers(byte mode)
 	}
 }
 
+// The colour stays on the bus, only nWR is strobed per pixel
 void UTFT::_fast_fill_16(int ch, int cl, long pix)
 { 
-    volatile uint32_t i;
-	for(i=0;i<pix;i++)
+	if (_band)
 	{
-		
-		LCD_Write_DATA(ch,cl);		  
-		
+		_band_fill((ch<<8)+cl, pix);
+		return;
 	}
+	if ((_tear_origin) && (pix>=UTFT_TE_MIN))
+		_tear_wait();
+	_tear_origin=false;
+#if defined(STM32F107xC)
+	_bus_pin_low(LCD_nCS_GPIO_Port, LCD_nCS_Pin);
+	_bus_pin_high(LCD_RS_GPIO_Port, LCD_RS_Pin);
+	GPIOE->ODR = (uint16_t)((ch<<8)+cl);
+	while (pix-->0)
+	{
+		_bus_wait(_bus_pad);
+		_bus_pin_low(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+		_bus_wait(_bus_pad);
+		_bus_pin_high(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+	}
+#else
+	while (pix-->0)
+		LCD_Write_DATA(ch,cl);
+#endif
 }
 
 void UTFT::_fast_fill_8(int ch, long pix)
@@ -162,119 +198,148 @@ void UTFT::_fast_fill_8(int ch, long pix)
 
 }
 
-__inline void UTFT::Blip(int numb)
+// Pixel data from RAM or flash, CS and RS are set once for the whole burst
+void UTFT::_burst_16(const uint16_t *buf, long pix)
 {
-	return;
-	for (int x=0;x<numb;x++)
+	if (_band)
 	{
-	HAL_GPIO_WritePin(POWER_DI_GPIO_Port,POWER_DI_Pin, GPIO_PIN_RESET);
-	delay(5);
-	HAL_GPIO_WritePin(POWER_DI_GPIO_Port,POWER_DI_Pin, GPIO_PIN_SET);
+		while (pix-->0)
+			_band_put(*buf++);
+		return;
 	}
-	delay(50);
+	if ((_tear_origin) && (pix>=UTFT_TE_MIN))
+		_tear_wait();
+	_tear_origin=false;
+#if defined(STM32F107xC)
+	_bus_pin_low(LCD_nCS_GPIO_Port, LCD_nCS_Pin);
+	_bus_pin_high(LCD_RS_GPIO_Port, LCD_RS_Pin);
+	while (pix-->0)
+	{
+		GPIOE->ODR = *buf++;
+		_bus_wait(_bus_pad);
+		_bus_pin_low(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+		_bus_wait(_bus_pad);
+		_bus_pin_high(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+	}
+#else
+	while (pix-->0)
+		TFT_LCD->RAM = *buf++;
+#endif
 }
 
-/*******************************************************************************
-* Function Name  : LCD_WriteReg
-* Description    : controller command
-* Input          : - cmd: writes command.
-* Output         : None
-* Return         : None
-* Attention		 : None
-*******************************************************************************/
-__inline void UTFT::LCD_Write_COM(int com1)
+// Little endian RGB565 byte pairs, optionally read from the last pixel back
+void UTFT::_burst_le(const uint8_t *buf, long pix, bool reverse)
 {
-	
-	
-	
-	
-	#if defined(STM32F107xC)
-	
-	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_RESET);
-	GPIOE->ODR = (uint16_t)com1;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	
+	int step=2;
+
+	if (reverse)
+	{
+		buf+=(pix-1)*2;
+		step=-2;
+	}
+	if (_band)
+	{
+		for (; pix>0; pix--, buf+=step)
+			_band_put(pgm_read_byte(&buf[0]) | (pgm_read_byte(&buf[1])<<8));
+		return;
+	}
+	_tear_origin=false;
+#if defined(STM32F107xC)
+	_bus_pin_low(LCD_nCS_GPIO_Port, LCD_nCS_Pin);
+	_bus_pin_high(LCD_RS_GPIO_Port, LCD_RS_Pin);
+	for (; pix>0; pix--, buf+=step)
+	{
+		GPIOE->ODR = pgm_read_byte(&buf[0]) | (pgm_read_byte(&buf[1])<<8);
+		_bus_wait(_bus_pad);
+		_bus_pin_low(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+		_bus_wait(_bus_pad);
+		_bus_pin_high(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+	}
 #else
-	TFT_LCD->REG = com1;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	#endif
+	for (; pix>0; pix--, buf+=step)
+		TFT_LCD->RAM = pgm_read_byte(&buf[0]) | (pgm_read_byte(&buf[1])<<8);
+#endif
 }
 
-
-/*******************************************************************************
-* Function Name  : LCD_WriteRAM
-* Description    : Writes to the LCD RAM.
-* Input          : - data: the pixel color in RGB mode (5-6-5).
-* Output         : None
-* Return         : None
-* Attention		 : None
-*******************************************************************************/
-__inline void UTFT::LCD_Write_DATA(int VL)					 
+// 1 bpp font data, n bytes: set bits in the foreground colour, clear ones in
+// the background colour, MSB first, or from the last byte back LSB first
+void UTFT::_burst_bits(const uint8_t *bits, int n, bool reverse)
 {
-	/* Write 8-bit data */
-	#if defined(STM32F107xC)
-	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nRD_GPIO_Port,LCD_nRD_Pin, GPIO_PIN_SET);
-	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
-	
-	GPIOE->ODR = (uint16_t)VL;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	#else
-	TFT_LCD->RAM = VL;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-		#endif
+	uint16_t	fg=(fch<<8)|fcl, bg=(bch<<8)|bcl;
+	int			step=1;
+	byte		ch, i;
+
+	if (reverse)
+	{
+		bits+=n-1;
+		step=-1;
+	}
+	if (_band)
+	{
+		for (; n>0; n--, bits+=step)
+		{
+			ch=pgm_read_byte(bits);
+			for (i=0; i<8; i++)
+				_band_put((ch & (reverse ? 0x01<<i : 0x80>>i)) ? fg : bg);
+		}
+		return;
+	}
+	_tear_origin=false;
+#if defined(STM32F107xC)
+	_bus_pin_low(LCD_nCS_GPIO_Port, LCD_nCS_Pin);
+	_bus_pin_high(LCD_RS_GPIO_Port, LCD_RS_Pin);
+	for (; n>0; n--, bits+=step)
+	{
+		ch=pgm_read_byte(bits);
+		for (i=0; i<8; i++)
+		{
+			GPIOE->ODR = (ch & (reverse ? 0x01<<i : 0x80>>i)) ? fg : bg;
+			_bus_wait(_bus_pad);
+			_bus_pin_low(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+			_bus_wait(_bus_pad);
+			_bus_pin_high(LCD_nWR_GPIO_Port, LCD_nWR_Pin);
+		}
+	}
+#else
+	for (; n>0; n--, bits+=step)
+	{
+		ch=pgm_read_byte(bits);
+		for (i=0; i<8; i++)
+			TFT_LCD->RAM = (ch & (reverse ? 0x01<<i : 0x80>>i)) ? fg : bg;
+	}
+#endif
 }
 
-__inline void UTFT::LCD_Write_DATA(int VH,int VL)
+// Words of the read cycle in progress, bus already turned round. nRD is
+// strobed on the port registers and held low while the panel drives the bus.
+void UTFT::_read_burst(uint16_t *buf, long n)
 {
-	
-	/* Write 16-bit data */
-	#if defined(STM32F107xC)
-	
-	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
-	
-	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
-	
-	GPIOE->ODR = (uint16_t)((VH<<8)+VL);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	#else
-	TFT_LCD->RAM = (uint16_t)((VH<<8)+VL);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-		#endif
+#if defined(STM32F107xC)
+	while (n-->0)
+	{
+		LCD_nRD_GPIO_Port->BRR=LCD_nRD_Pin;
+		USER_delay_ns(UTFT_RD_LOW);
+		*buf++=GPIOE->IDR;
+		LCD_nRD_GPIO_Port->BSRR=LCD_nRD_Pin;
+	}
+#else
+	while (n-->0)
+		*buf++=TFT_LCD->RAM;
+#endif
 }
 
-__inline void UTFT::LCD_Write_COM_DATA(int com1,int dat1)
+__inline void UTFT::Blip(int numb)
 {
-	LCD_Write_COM(com1);
-	LCD_Write_DATA(dat1);
-
 	return;
-		#if defined(STM32F107xC)
-		HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_RESET);
-	GPIOE->ODR = (uint16_t)com1;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
-	GPIOE->ODR = (uint16_t)dat1;
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-	#else
-	
-     TFT_LCD->REG = com1;
-     
-	 TFT_LCD->RAM = dat1;
-	 HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
-		#endif
+	for (int x=0;x<numb;x++)
+	{
+	HAL_GPIO_WritePin(POWER_DI_GPIO_Port,POWER_DI_Pin, GPIO_PIN_RESET);
+	delay(5);
+	HAL_GPIO_WritePin(POWER_DI_GPIO_Port,POWER_DI_Pin, GPIO_PIN_SET);
+	}
+	delay(50);
 }
+
 void set_register(byte mode)
 {
 GPIO_InitTypeDef GPIO_InitStruct;
@@ -286,7 +351,7 @@ GPIO_InitTypeDef GPIO_InitStruct;
         HAL_GPIO_WritePin(GPIOE, 0xffff, GPIO_PIN_RESET);
         GPIO_InitStruct.Pin = 0xffff;
         GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+        GPIO_InitStruct.Speed = _bus_speed;
 		HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
   break;
   case 1:
@@ -346,7 +411,7 @@ __inline uint16_t UTFT::LCD_ReadData(void)
   HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET); //reg select high
 
   set_register(1);
-  delay(10);
+  USER_delay_ns(UTFT_RD_LOW);
    //first clock is dummy so remember to throw those away
   
   HAL_GPIO_WritePin(LCD_nRD_GPIO_Port,LCD_nRD_Pin, GPIO_PIN_RESET);
@@ -366,6 +431,20 @@ __inline uint16_t UTFT::LCD_ReadData(void)
 }
 
 
+// Switches to one of the bus timing profiles (0 the fastest), e.g. one found
+// by tuneBus() on an earlier boot
+void UTFT::setBusProfile(byte profile)
+{
+	if (profile>=UTFT_BUS_PROFILES)
+		profile=UTFT_BUS_PROFILES-1;
+	_bus_profile=profile;
+	_bus_pad=_bus_profiles[profile].pad;
+	_bus_speed=_bus_profiles[profile].speed;
+#if defined(STM32F107xC)
+	set_register(0);
+#endif
+}
+
 #if defined ( __GNUC__ )
 #pragma GCC diagnostic pop
 #endif
@@ -0,0 +1,149 @@
+// *** Hardwarespecific functions: LCD bus writes ***
+// Inline so that the controller drivers in their own files (tft_drivers/*/setxy.cpp)
+// write the bus as directly as UTFT.cpp does.
+
+#ifndef __HW_STM32F_BUS_H__
+#define __HW_STM32F_BUS_H__
+
+typedef struct
+{
+	volatile uint16_t  REG;
+	volatile uint16_t  RAM;
+} LCD_IO_TypeDef;
+
+#define TFT_LCD_BASE 0x40011800
+#define   TFT_LCD             ((LCD_IO_TypeDef *) TFT_LCD_BASE)
+
+// Padding between the data and the nWR edges, in NOPs (see setBusProfile()).
+// Always inlined, the UTFT_RAMFUNC loops must not call back into flash.
+static inline __attribute__((always_inline)) void _bus_wait(byte n)
+{
+	while (n--)
+		__asm__ __volatile__ ("nop");
+}
+
+// Control lines on the port set/reset registers, for the pixel loops where a
+// HAL call per edge would cost more than the write itself
+#define _bus_pin_low(port, pin)		((port)->BRR=(pin))
+#define _bus_pin_high(port, pin)	((port)->BSRR=(pin))
+
+/*******************************************************************************
+* Function Name  : LCD_WriteReg
+* Description    : controller command
+* Input          : - cmd: writes command.
+* Output         : None
+* Return         : None
+* Attention		 : None
+*******************************************************************************/
+inline void UTFT::LCD_Write_COM(int com1)
+{
+	
+	
+	
+	
+	#if defined(STM32F107xC)
+	
+	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_RESET);
+	GPIOE->ODR = (uint16_t)com1;
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	
+#else
+	TFT_LCD->REG = com1;
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	#endif
+}
+
+
+/*******************************************************************************
+* Function Name  : LCD_WriteRAM
+* Description    : Writes to the LCD RAM.
+* Input          : - data: the pixel color in RGB mode (5-6-5).
+* Output         : None
+* Return         : None
+* Attention		 : None
+*******************************************************************************/
+inline void UTFT::LCD_Write_DATA(int VL)					 
+{
+	if (_band)
+	{
+		_band_put(VL);
+		return;
+	}
+	_tear_origin=false;
+	/* Write 8-bit data */
+	#if defined(STM32F107xC)
+	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_nRD_GPIO_Port,LCD_nRD_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
+	
+	GPIOE->ODR = (uint16_t)VL;
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	#else
+	TFT_LCD->RAM = VL;
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+		#endif
+}
+
+inline void UTFT::LCD_Write_DATA(int VH,int VL)
+{
+	if (_band)
+	{
+		_band_put((VH<<8)+VL);
+		return;
+	}
+	_tear_origin=false;
+	/* Write 16-bit data */
+	#if defined(STM32F107xC)
+	
+	HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
+	
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
+	
+	GPIOE->ODR = (uint16_t)((VH<<8)+VL);
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	_bus_wait(_bus_pad);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	#else
+	TFT_LCD->RAM = (uint16_t)((VH<<8)+VL);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+		#endif
+}
+
+inline void UTFT::LCD_Write_COM_DATA(int com1,int dat1)
+{
+	LCD_Write_COM(com1);
+	LCD_Write_DATA(dat1);
+
+	return;
+		#if defined(STM32F107xC)
+		HAL_GPIO_WritePin(LCD_nCS_GPIO_Port,LCD_nCS_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_RESET);
+	GPIOE->ODR = (uint16_t)com1;
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(LCD_RS_GPIO_Port,LCD_RS_Pin, GPIO_PIN_SET);
+	GPIOE->ODR = (uint16_t)dat1;
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+	#else
+	
+     TFT_LCD->REG = com1;
+     
+	 TFT_LCD->RAM = dat1;
+	 HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_RESET);
+		HAL_GPIO_WritePin(LCD_nWR_GPIO_Port,LCD_nWR_Pin, GPIO_PIN_SET);
+		#endif
+}
+
+#endif
@@ -11,11 +11,7 @@ UTFT_SPFD5420::UTFT_SPFD5420()
 
 void UTFT_SPFD5420::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/SPFD5420/initlcd.h"
-    }
+	_init_table(_init_SPFD5420);
 
 #include "tft_drivers/common/head2.h"
 }
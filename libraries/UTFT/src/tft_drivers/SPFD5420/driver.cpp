@@ -0,0 +1,9 @@
+/*
+  SPFD5420 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(SPFD5420, 0x5420, 239, 399, 16, _init_SPFD5420, _setxy_spfd5420, 0);
@@ -1,135 +1,74 @@
-case SPFD5420:
-	LCD_Write_COM(0x0000);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0X0001);  
-    LCD_Write_DATA(0X0100);
-    LCD_Write_COM(0X0002);  
-    LCD_Write_DATA(0X0100);
-    
-    LCD_Write_COM(0X0003);  
-    LCD_Write_DATA(0X1030);
-    LCD_Write_COM(0x0008);  
-    LCD_Write_DATA(0x0808); 
-    LCD_Write_COM(0x0009);  
-    LCD_Write_DATA(0x0001);
-    LCD_Write_COM(0x000B);  
-    LCD_Write_DATA(0x0010); 
-    LCD_Write_COM(0x000C);  
-    LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x000F);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0007);  
-    LCD_Write_DATA(0x0001);
-    LCD_Write_COM(0x0010);  
-    LCD_Write_DATA(0x0013); 
-    LCD_Write_COM(0x0011);  
-    LCD_Write_DATA(0x0501);
-    LCD_Write_COM(0x0012);  
-    LCD_Write_DATA(0x0300); 
-    LCD_Write_COM(0x0020);  
-    LCD_Write_DATA(0x021E);
-    LCD_Write_COM(0x0021);  
-    LCD_Write_DATA(0x0202); 
-    LCD_Write_COM(0x0090);  
-    LCD_Write_DATA(0x8000);
-    LCD_Write_COM(0x0100);  
-    LCD_Write_DATA(0x17B0); 
-    LCD_Write_COM(0x0101);  
-    LCD_Write_DATA(0x0147);
-    LCD_Write_COM(0x0102);  
-    LCD_Write_DATA(0x0135); 
-    LCD_Write_COM(0x0103);  
-    LCD_Write_DATA(0x0700);
-    LCD_Write_COM(0x0107);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0110);  
-    LCD_Write_DATA(0x0001);
-    LCD_Write_COM(0x0210);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0211);  
-    LCD_Write_DATA(0x00EF);
-    LCD_Write_COM(0x0212);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0213);  
-    LCD_Write_DATA(0x018F);
-    LCD_Write_COM(0x0280);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0281);  
-    LCD_Write_DATA(0x000f);
-    LCD_Write_COM(0x0282);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0300);  
-    LCD_Write_DATA(0x0101);
-    LCD_Write_COM(0x0301);  
-    LCD_Write_DATA(0x0B2C); 
-    LCD_Write_COM(0x0302);  
-    LCD_Write_DATA(0x1030);
-    LCD_Write_COM(0x0303);  
-    LCD_Write_DATA(0x3010); 
-    LCD_Write_COM(0x0304); LCD_Write_DATA(0x2C0B);
-    LCD_Write_COM(0x0305);  
-    LCD_Write_DATA(0x0101); 
-    LCD_Write_COM(0x0306);  
-    LCD_Write_DATA(0x0807);
-    LCD_Write_COM(0x0307); LCD_Write_DATA(0x0708); 
-    LCD_Write_COM(0x0308); LCD_Write_DATA(0x0107);
-    LCD_Write_COM(0x0309);  
-    LCD_Write_DATA(0x0105); 
-    LCD_Write_COM(0x030A);  
-    LCD_Write_DATA(0x0F04);
-    LCD_Write_COM(0x030B);  
-    LCD_Write_DATA(0x0F00); 
-    LCD_Write_COM(0x030C);  
-    LCD_Write_DATA(0x000F);
-    LCD_Write_COM(0x030D);  
-    LCD_Write_DATA(0x040F); 
-    LCD_Write_COM(0x030E);  
-    LCD_Write_DATA(0x0300);
-    LCD_Write_COM(0x030F);  
-    LCD_Write_DATA(0x0701); 
-    LCD_Write_COM(0x0400); 
-    LCD_Write_DATA(0x3500); //(01H==0x0000,400H==0xB504,ԭΪԽ)
-    LCD_Write_COM(0x0401);  
-    LCD_Write_DATA(0x0001); 
-    LCD_Write_COM(0x0404);  
-    LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x0500);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0501);  LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x0502);  LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0503);  LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x0504);  LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0505);  LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x0606);  LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x06F0);  
-    LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x07F0);  
-    LCD_Write_DATA(0x5420); 
-    LCD_Write_COM(0x07DE);  
-    LCD_Write_DATA(0x0000);
-    LCD_Write_COM(0x07F2);  
-    LCD_Write_DATA(0x00DF); 
-    LCD_Write_COM(0x07F3);  
-    LCD_Write_DATA(0x0810);
-    LCD_Write_COM(0x07F4);  
-    LCD_Write_DATA(0x0077); 
-    LCD_Write_COM(0x07F5);  
-    LCD_Write_DATA(0x0021);
-    LCD_Write_COM(0x07F0);  
-    LCD_Write_DATA(0x0000); 
-    LCD_Write_COM(0x0007);  
-    LCD_Write_DATA(0x0173);
-
-    LCD_Write_COM(0x0210);  
-    LCD_Write_DATA(0); 
-    LCD_Write_COM(0x0211);  
-    LCD_Write_DATA(239);
-    LCD_Write_COM(0x0212);  
-    LCD_Write_DATA(0); 
-    LCD_Write_COM(0x0213);  
-    LCD_Write_DATA(399);
-    LCD_Write_COM(0x0200);  
-    LCD_Write_DATA(0); 
-    LCD_Write_COM(0x0201);  
-    LCD_Write_DATA(0);
-	break;
+// SPFD5420
+static const uint8_t _init_SPFD5420[]={
+	1,	0x00, 0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x01, 0x01,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x02, 0x01,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x03, 0x10,0x30,
+	UTFT_INIT_WORDS|1,	0x00,0x08, 0x08,0x08,
+	1,	0x09, 0x01,
+	1,	0x0B, 0x10,
+	1,	0x0C, 0x00,
+	1,	0x0F, 0x00,
+	1,	0x07, 0x01,
+	1,	0x10, 0x13,
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x05,0x01,
+	UTFT_INIT_WORDS|1,	0x00,0x12, 0x03,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x20, 0x02,0x1E,
+	UTFT_INIT_WORDS|1,	0x00,0x21, 0x02,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x90, 0x80,0x00,
+	UTFT_INIT_WORDS|1,	0x01,0x00, 0x17,0xB0,
+	UTFT_INIT_WORDS|1,	0x01,0x01, 0x01,0x47,
+	UTFT_INIT_WORDS|1,	0x01,0x02, 0x01,0x35,
+	UTFT_INIT_WORDS|1,	0x01,0x03, 0x07,0x00,
+	UTFT_INIT_WORDS|1,	0x01,0x07, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x01,0x10, 0x00,0x01,
+	UTFT_INIT_WORDS|1,	0x02,0x10, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x11, 0x00,0xEF,
+	UTFT_INIT_WORDS|1,	0x02,0x12, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x13, 0x01,0x8F,
+	UTFT_INIT_WORDS|1,	0x02,0x80, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x81, 0x00,0x0F,
+	UTFT_INIT_WORDS|1,	0x02,0x82, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x03,0x00, 0x01,0x01,
+	UTFT_INIT_WORDS|1,	0x03,0x01, 0x0B,0x2C,
+	UTFT_INIT_WORDS|1,	0x03,0x02, 0x10,0x30,
+	UTFT_INIT_WORDS|1,	0x03,0x03, 0x30,0x10,
+	UTFT_INIT_WORDS|1,	0x03,0x04, 0x2C,0x0B,
+	UTFT_INIT_WORDS|1,	0x03,0x05, 0x01,0x01,
+	UTFT_INIT_WORDS|1,	0x03,0x06, 0x08,0x07,
+	UTFT_INIT_WORDS|1,	0x03,0x07, 0x07,0x08,
+	UTFT_INIT_WORDS|1,	0x03,0x08, 0x01,0x07,
+	UTFT_INIT_WORDS|1,	0x03,0x09, 0x01,0x05,
+	UTFT_INIT_WORDS|1,	0x03,0x0A, 0x0F,0x04,
+	UTFT_INIT_WORDS|1,	0x03,0x0B, 0x0F,0x00,
+	UTFT_INIT_WORDS|1,	0x03,0x0C, 0x00,0x0F,
+	UTFT_INIT_WORDS|1,	0x03,0x0D, 0x04,0x0F,
+	UTFT_INIT_WORDS|1,	0x03,0x0E, 0x03,0x00,
+	UTFT_INIT_WORDS|1,	0x03,0x0F, 0x07,0x01,
+	UTFT_INIT_WORDS|1,	0x04,0x00, 0x35,0x00,		// (01H==0x0000,400H==0xB504,Ô­µãÉèÖÃÎª¶Ô½Ç)
+	UTFT_INIT_WORDS|1,	0x04,0x01, 0x00,0x01,
+	UTFT_INIT_WORDS|1,	0x04,0x04, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x00, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x01, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x02, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x03, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x04, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x05,0x05, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x06,0x06, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x06,0xF0, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x07,0xF0, 0x54,0x20,
+	UTFT_INIT_WORDS|1,	0x07,0xDE, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x07,0xF2, 0x00,0xDF,
+	UTFT_INIT_WORDS|1,	0x07,0xF3, 0x08,0x10,
+	UTFT_INIT_WORDS|1,	0x07,0xF4, 0x00,0x77,
+	UTFT_INIT_WORDS|1,	0x07,0xF5, 0x00,0x21,
+	UTFT_INIT_WORDS|1,	0x07,0xF0, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x07, 0x01,0x73,
+	UTFT_INIT_WORDS|1,	0x02,0x10, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x11, 0x00,0xEF,
+	UTFT_INIT_WORDS|1,	0x02,0x12, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x13, 0x01,0x8F,
+	UTFT_INIT_WORDS|1,	0x02,0x00, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x02,0x01, 0x00,0x00,
+	UTFT_INIT_END
+};
@@ -0,0 +1,23 @@
+/*
+  SPFD5420 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_spfd5420(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM(0x210);
+	lcd->LCD_Write_DATA(x1);
+	lcd->LCD_Write_COM(0x211);
+	lcd->LCD_Write_DATA(x2);
+	lcd->LCD_Write_COM(0x212);
+	lcd->LCD_Write_DATA(y1);
+	lcd->LCD_Write_COM(0x213);
+	lcd->LCD_Write_DATA(y2);
+	lcd->LCD_Write_COM(0x200);
+	lcd->LCD_Write_DATA(x1);
+	lcd->LCD_Write_COM(0x201);
+	lcd->LCD_Write_DATA(y1);
+	lcd->LCD_Write_COM(0x202);
+}
@@ -0,0 +1,43 @@
+/*
+  Drivers kept when the sketch does not name its own with UTFT_DRIVERS():
+  the BSP_TFT_LCD controller (for UTFT_AUTO the ones it can detect), or every
+  driver when the board sets none.
+*/
+
+#include "UTFT.h"
+
+#if __has_include("bsp.h")
+#  include "bsp.h"
+#endif
+
+#ifndef BSP_TFT_LCD
+# define DRIVERS(f)	f(HX8347A) f(ILI9327) f(SSD1289) f(SSD1289_8) f(SSD1289LATCHED) f(ILI9325C) \
+					f(ILI9325D_8) f(ILI9325D_16) f(ILI9325D_16ALT) f(HX8340B_8) f(HX8340B_S) f(ST7735) \
+					f(ST7735_ALT) f(PCF8833) f(S1D19122) f(HX8352A) f(SSD1963_480) f(SSD1963_800) \
+					f(SSD1963_800ALT) f(S6D1121_8) f(S6D1121_16) f(ILI9481) f(S6D0164) f(ST7735S) \
+					f(ILI9341_S4P) f(ILI9341_S5P) f(ILI9341_16) f(R61581) f(ILI9486) f(CPLD) \
+					f(HX8353C) f(ILI9320) f(SPFD5420)
+#elif (BSP_TFT_LCD==UTFT_AUTO)
+# define DRIVERS(f)	f(ILI9325D_16ALT) f(ILI9341_16) f(ILI9481) f(ILI9486) f(ILI9320) f(SPFD5420)
+#elif (BSP_TFT_LCD==ILI9320) || (BSP_TFT_LCD==0x9320)
+# define DRIVERS(f)	f(ILI9320)
+#elif (BSP_TFT_LCD==ILI9325) || (BSP_TFT_LCD==0x9325)
+# define DRIVERS(f)	f(ILI9325D_16) f(ILI9325D_16ALT)
+#elif (BSP_TFT_LCD==ILI9327) || (BSP_TFT_LCD==0x9327)
+# define DRIVERS(f)	f(ILI9327)
+#elif (BSP_TFT_LCD==ILI9341_16) || (BSP_TFT_LCD==0x9341)
+# define DRIVERS(f)	f(ILI9341_16)
+#elif (BSP_TFT_LCD==ILI9481) || (BSP_TFT_LCD==0x9481)
+# define DRIVERS(f)	f(ILI9481)
+#elif (BSP_TFT_LCD==ILI9486) || (BSP_TFT_LCD==0x9486)
+# define DRIVERS(f)	f(ILI9486)
+#elif (BSP_TFT_LCD==SPFD5420) || (BSP_TFT_LCD==0x5420)
+# define DRIVERS(f)	f(SPFD5420)
+#else
+# define DRIVERS(f)	f(BSP_TFT_LCD)
+#endif
+
+DRIVERS(_UTFT_DRIVER_DECL)
+
+extern const UTFT_Driver *const _utft_drivers_used[] __attribute__((weak));
+const UTFT_Driver *const _utft_drivers_used[] = {DRIVERS(_UTFT_DRIVER_REF) 0};
@@ -2,4 +2,6 @@
 	setColor(255, 255, 255);
 	setBackColor(0, 0, 0);
 	cfont.font=0;
+	cfont.source=0;
+	cfont.packed=0;
 	_transparent = false;
@@ -0,0 +1,49 @@
+/*
+  Address window of the controllers that share a register layout
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+// MIPI DCS column/page address set: ILI9341, ILI9481, R61581, HX8353C,
+// HX8340B (serial), ST7735, ST7735S, S1D19122
+void _setxy_dcs(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM(0x2a);
+	lcd->LCD_Write_DATA(x1>>8);
+	lcd->LCD_Write_DATA(x1);
+	lcd->LCD_Write_DATA(x2>>8);
+	lcd->LCD_Write_DATA(x2);
+	lcd->LCD_Write_COM(0x2b);
+	lcd->LCD_Write_DATA(y1>>8);
+	lcd->LCD_Write_DATA(y1);
+	lcd->LCD_Write_DATA(y2>>8);
+	lcd->LCD_Write_DATA(y2);
+	lcd->LCD_Write_COM(0x2c);
+}
+
+// ILI9320, ILI9325C, ILI9325D
+void _setxy_ili932x(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x20,x1);
+	lcd->LCD_Write_COM_DATA(0x21,y1);
+	lcd->LCD_Write_COM_DATA(0x50,x1);
+	lcd->LCD_Write_COM_DATA(0x52,y1);
+	lcd->LCD_Write_COM_DATA(0x51,x2);
+	lcd->LCD_Write_COM_DATA(0x53,y2);
+	lcd->LCD_Write_COM(0x22);
+}
+
+// HX8347A, HX8352A
+void _setxy_hx8347(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x02,x1>>8);
+	lcd->LCD_Write_COM_DATA(0x03,x1);
+	lcd->LCD_Write_COM_DATA(0x04,x2>>8);
+	lcd->LCD_Write_COM_DATA(0x05,x2);
+	lcd->LCD_Write_COM_DATA(0x06,y1>>8);
+	lcd->LCD_Write_COM_DATA(0x07,y1);
+	lcd->LCD_Write_COM_DATA(0x08,y2>>8);
+	lcd->LCD_Write_COM_DATA(0x09,y2);
+	lcd->LCD_Write_COM(0x22);
+}
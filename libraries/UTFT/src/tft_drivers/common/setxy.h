@@ -0,0 +1,17 @@
+// Address window routines, one per controller register layout. Each lives
+// in its own tft_drivers/*/setxy.cpp, so a build only keeps the ones its
+// linked drivers point at.
+
+void _setxy_dcs(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_ili932x(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_hx8347(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_ssd1289(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_hx8340b_8(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_spfd5420(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_s6d0164(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_s6d1121(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_pcf8833(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_ili9327(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_cpld(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_ili9486(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+void _setxy_ssd1963(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
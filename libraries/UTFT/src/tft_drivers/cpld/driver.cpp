@@ -0,0 +1,18 @@
+/*
+  CPLD driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+// The CPLD boards are mounted the other way round
+static void _init_done_cpld(UTFT *lcd)
+{
+	if (lcd->orient==LANDSCAPE)
+		lcd->orient = PORTRAIT;
+	else
+		lcd->orient = LANDSCAPE;
+}
+
+UTFT_DRIVER(CPLD, 0, 799, 479, 16, _init_CPLD, _setxy_cpld, _init_done_cpld);
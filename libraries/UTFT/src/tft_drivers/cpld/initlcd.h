@@ -1,10 +1,7 @@
-case CPLD:
-	if (orient==LANDSCAPE)
-		orient = PORTRAIT;
-	else
-		orient = LANDSCAPE;
-
-	LCD_Write_COM(0x0F);   
-	LCD_Write_COM_DATA(0x01,0x0010);
-	LCD_Write_COM(0x0F);   
-	break;
+// CPLD, the orientation is flipped by driver.cpp
+static const uint8_t _init_CPLD[]={
+	0,	0x0F,
+	UTFT_INIT_WORDS|1,	0x00,0x01, 0x00,0x10,
+	0,	0x0F,
+	UTFT_INIT_END
+};
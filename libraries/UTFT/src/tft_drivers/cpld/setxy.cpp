@@ -0,0 +1,15 @@
+/*
+  CPLD address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_cpld(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x02, y1);
+	lcd->LCD_Write_COM_DATA(0x03, x1);
+	lcd->LCD_Write_COM_DATA(0x06, y2);
+	lcd->LCD_Write_COM_DATA(0x07, x2);
+	lcd->LCD_Write_COM(0x0F);
+}
@@ -0,0 +1,9 @@
+/*
+  HX8340-B driver (8 bit)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(HX8340B_8, 0, 175, 219, 8, _init_HX8340B_8, _setxy_hx8340b_8, 0);
@@ -0,0 +1,19 @@
+/*
+  HX8340B (8 bit) address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_hx8340b_8(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x02,0x0000);
+	lcd->LCD_Write_COM_DATA(0x03,x1);
+	lcd->LCD_Write_COM_DATA(0x04,0x0000);
+	lcd->LCD_Write_COM_DATA(0x05,x2);
+	lcd->LCD_Write_COM_DATA(0x06,0x0000);
+	lcd->LCD_Write_COM_DATA(0x07,y1);
+	lcd->LCD_Write_COM_DATA(0x08,0x0000);
+	lcd->LCD_Write_COM_DATA(0x09,y2);
+	lcd->LCD_Write_COM(0x22);
+}
@@ -0,0 +1,9 @@
+/*
+  HX8340-B driver (serial)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(HX8340B_S, 0, 175, 219, SERIAL_4PIN, _init_HX8340B_S, _setxy_dcs, 0);
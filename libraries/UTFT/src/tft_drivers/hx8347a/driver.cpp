@@ -0,0 +1,9 @@
+/*
+  HX8347-A driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(HX8347A, 0x0047, 239, 319, 16, _init_HX8347A, _setxy_hx8347, 0);
@@ -0,0 +1,9 @@
+/*
+  HX8352-A driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(HX8352A, 0, 239, 399, 16, _init_HX8352A, _setxy_hx8347, 0);
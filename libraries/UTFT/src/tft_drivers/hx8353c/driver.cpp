@@ -0,0 +1,32 @@
+/*
+  HX8353C driver
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+// MADCTL for the orientation on the F107, the colour lookup table elsewhere
+static void _init_done_hx8353c(UTFT *lcd)
+{
+#if defined(STM32F107xC)
+	lcd->LCD_Write_COM(0x36);
+	if (lcd->orient==LANDSCAPE)
+		lcd->LCD_Write_DATA(0x64);	// rotate 180deg
+	else
+		lcd->LCD_Write_DATA(0xA4);	// orientation
+	lcd->LCD_Write_COM(0x2C);
+#else
+	for (int j=0; j<32; j++)
+		lcd->LCD_Write_DATA(2*j);	// Red
+	for (int j=0; j<64; j++)
+		lcd->LCD_Write_DATA(1*j);	// Green
+	for (int j=0; j<32; j++)
+		lcd->LCD_Write_DATA(2*j);	// Blue
+	lcd->LCD_Write_COM(0x2C);
+	delay(150);
+#endif
+}
+
+UTFT_DRIVER(HX8353C, 0, 239, 319, 8, _init_HX8353C, _setxy_dcs, _init_done_hx8353c);
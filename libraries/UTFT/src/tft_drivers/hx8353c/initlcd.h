@@ -1,182 +1,48 @@
-case HX8353C:
-	
-//new init
 #if defined(STM32F107xC)
-
-		LCD_Write_COM(0xFE);                     // lcd Type check
-      LCD_Write_COM(0xEF);
-      LCD_Write_COM(0x36);
-
-		if (orient==1)
-		{LCD_Write_DATA(0x64);//rotate 180deg
-		}
-		else
-		{
-			LCD_Write_DATA(0xa4);//orientation
-		}
-	  LCD_Write_COM(0x3A);
-      LCD_Write_DATA(5);
-      LCD_Write_COM(0xE8);
-      LCD_Write_DATA(0x12);
-      LCD_Write_DATA(0x22);
-      LCD_Write_COM(0xE3);
-      LCD_Write_DATA(1);
-      LCD_Write_DATA(4);
-      LCD_Write_COM(0xA5);
-      LCD_Write_DATA(0x40);
-      LCD_Write_DATA(0x40);
-      LCD_Write_COM(0xA4);
-      LCD_Write_DATA(0x44);
-      LCD_Write_DATA(0x44);
-      LCD_Write_COM(0xAB);
-      LCD_Write_DATA(8);
-      LCD_Write_COM(0xAA);
-      LCD_Write_DATA(0x88);
-      LCD_Write_DATA(0x88);
-      LCD_Write_COM(0xAE);
-      LCD_Write_DATA(0xB);
-      LCD_Write_COM(0xAC);
-      LCD_Write_DATA(0);
-      LCD_Write_COM(0xAF);
-      LCD_Write_DATA(0x77);
-      LCD_Write_COM(0xAD);
-      LCD_Write_DATA(0x77);
-      
-      LCD_Write_COM(0x2A);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0xEF);
-      LCD_Write_COM(0x2B);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(1);
-      LCD_Write_DATA(0x3F);
-      
-      LCD_Write_COM(0x2C);
-      
-      LCD_Write_COM(0xF0);
-      LCD_Write_DATA(2);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(1);
-      LCD_Write_DATA(1);
-      LCD_Write_DATA(7);
-      
-      LCD_Write_COM(0xF1);
-      LCD_Write_DATA(1);
-      LCD_Write_DATA(3);
-      LCD_Write_DATA(0);
-      LCD_Write_DATA(0x36);
-      LCD_Write_DATA(41);
-      LCD_Write_DATA(0x13);
-      
-      LCD_Write_COM(0xF2);
-      LCD_Write_DATA(8);
-      LCD_Write_DATA(6);
-      LCD_Write_DATA(0x24);
-      LCD_Write_DATA(3);
-      LCD_Write_DATA(5);
-      LCD_Write_DATA(0x34);
-      
-      LCD_Write_COM(0xF3);
-      LCD_Write_DATA(0x16);
-      LCD_Write_DATA(0xC);
-      LCD_Write_DATA(0x5A);
-      LCD_Write_DATA(4);
-      LCD_Write_DATA(3);
-      LCD_Write_DATA(0x69);
-      
-      LCD_Write_COM(0xF4);
-      LCD_Write_DATA(0xD);
-      LCD_Write_DATA(0x18);
-      LCD_Write_DATA(0x15);
-      LCD_Write_DATA(5);
-      LCD_Write_DATA(5);
-      LCD_Write_DATA(0);
-      
-      LCD_Write_COM(0xF5);
-      LCD_Write_DATA(0xD);
-      LCD_Write_DATA(0x18);
-      LCD_Write_DATA(0x17);
-      LCD_Write_DATA(0x35);
-      LCD_Write_DATA(0x39);
-      LCD_Write_DATA(0);
-      LCD_Write_COM(0x11);
-	
-	delay(150);
-      LCD_Write_COM(0x29);
-      LCD_Write_COM(0x2C);
-	
-		break;
-	#else
-	
-	LCD_Write_COM(0xB9);//SETEXTC
-		LCD_Write_DATA(0xFF);
-		LCD_Write_DATA(0x83);
-		LCD_Write_DATA(0x53);
-
-		LCD_Write_COM(0xB0);//RADJ
-		LCD_Write_DATA(0x3C);
-		LCD_Write_DATA(0x01);
-
-		LCD_Write_COM(0xB6);//VCOM
-		LCD_Write_DATA(0x94);
-		LCD_Write_DATA(0x6C);
-		LCD_Write_DATA(0x50);   
-
-		LCD_Write_COM(0xB1);//PWR
-		LCD_Write_DATA(0x00);
-		LCD_Write_DATA(0x01);
-		LCD_Write_DATA(0x1B);
-		LCD_Write_DATA(0x03);
-		LCD_Write_DATA(0x01);
-		LCD_Write_DATA(0x08);
-		LCD_Write_DATA(0x77);
-		LCD_Write_DATA(0x89);
-
-		LCD_Write_COM(0xE0); //Gamma setting for tpo Panel
-		LCD_Write_DATA(0x50);
-		LCD_Write_DATA(0x77);
-		LCD_Write_DATA(0x40);
-		LCD_Write_DATA(0x08);
-		LCD_Write_DATA(0xBF);
-		LCD_Write_DATA(0x00);
-		LCD_Write_DATA(0x03);
-		LCD_Write_DATA(0x0F);
-		LCD_Write_DATA(0x00);
-		LCD_Write_DATA(0x01);
-		LCD_Write_DATA(0x73);
-		LCD_Write_DATA(0x00);
-		LCD_Write_DATA(0x72);
-		LCD_Write_DATA(0x03);
-		LCD_Write_DATA(0xB0);
-		LCD_Write_DATA(0x0F);
-		LCD_Write_DATA(0x08);
-		LCD_Write_DATA(0x00);
-		LCD_Write_DATA(0x0F);
-
-		LCD_Write_COM(0x3A);   
-		LCD_Write_DATA(0x05);  //05 
-		LCD_Write_COM(0x36);    
-		LCD_Write_DATA(0xC0); //83  //0B 
-
-		LCD_Write_COM(0x11); // SLPOUT  
-		delay(150);
-
-		LCD_Write_COM(0x29);    // display on
-
-		delay(150);
-		LCD_Write_COM(0x2D);  //Look up table
-
-		for(int j=0;j<32;j++)
-		{ LCD_Write_DATA(2*j); } //Red
-		for(int j=0;j<64;j++)
-		{ LCD_Write_DATA(1*j); } //Green
-		for(int j=0;j<32;j++)
-		{ LCD_Write_DATA(2*j); } //Blue 
-
-		LCD_Write_COM(0x2c);  
-		delay(150);	 
-	break;
-#endif
\ No newline at end of file
+// HX8353C, MADCTL depends on the orientation and is set by driver.cpp
+static const uint8_t _init_HX8353C[]={
+	0,	0xFE,		// lcd Type check
+	0,	0xEF,
+	1,	0x3A, 0x05,
+	2,	0xE8, 0x12, 0x22,
+	2,	0xE3, 0x01, 0x04,
+	2,	0xA5, 0x40, 0x40,
+	2,	0xA4, 0x44, 0x44,
+	1,	0xAB, 0x08,
+	2,	0xAA, 0x88, 0x88,
+	1,	0xAE, 0x0B,
+	1,	0xAC, 0x00,
+	1,	0xAF, 0x77,
+	1,	0xAD, 0x77,
+	4,	0x2A, 0x00, 0x00, 0x00, 0xEF,
+	4,	0x2B, 0x00, 0x00, 0x01, 0x3F,
+	0,	0x2C,
+	6,	0xF0, 0x02, 0x00, 0x00, 0x01, 0x01, 0x07,
+	6,	0xF1, 0x01, 0x03, 0x00, 0x36, 0x29, 0x13,
+	6,	0xF2, 0x08, 0x06, 0x24, 0x03, 0x05, 0x34,
+	6,	0xF3, 0x16, 0x0C, 0x5A, 0x04, 0x03, 0x69,
+	6,	0xF4, 0x0D, 0x18, 0x15, 0x05, 0x05, 0x00,
+	6,	0xF5, 0x0D, 0x18, 0x17, 0x35, 0x39, 0x00,
+	0,	0x11,
+	UTFT_INIT_DELAY, 150,
+	0,	0x29,
+	UTFT_INIT_END
+};
+#else
+// HX8353C, the colour lookup table is sent by driver.cpp
+static const uint8_t _init_HX8353C[]={
+	3,	0xB9, 0xFF, 0x83, 0x53,		// SETEXTC
+	2,	0xB0, 0x3C, 0x01,		// RADJ
+	3,	0xB6, 0x94, 0x6C, 0x50,		// VCOM
+	8,	0xB1, 0x00, 0x01, 0x1B, 0x03, 0x01, 0x08, 0x77, 0x89,		// PWR
+	19,	0xE0, 0x50, 0x77, 0x40, 0x08, 0xBF, 0x00, 0x03, 0x0F, 0x00, 0x01, 0x73, 0x00, 0x72, 0x03, 0xB0, 0x0F, 0x08, 0x00, 0x0F,		// Gamma setting for tpo Panel
+	1,	0x3A, 0x05,		// 05
+	1,	0x36, 0xC0,		// 83  //0B
+	0,	0x11,		// SLPOUT
+	UTFT_INIT_DELAY, 150,
+	0,	0x29,		// display on
+	UTFT_INIT_DELAY, 150,
+	0,	0x2D,		// Look up table
+	UTFT_INIT_END
+};
+#endif
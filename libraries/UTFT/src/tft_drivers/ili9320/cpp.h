@@ -10,10 +10,6 @@ UTFT_ILI9320::UTFT_ILI9320()
 
 void UTFT_ILI9320::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/ili9320/initlcd.h"
-    }
+	_init_table(_init_ILI9320);
 #include "tft_drivers/common/head2.h"
 }
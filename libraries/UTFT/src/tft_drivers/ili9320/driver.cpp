@@ -0,0 +1,9 @@
+/*
+  ILI9320 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9320, 0x9320, 239, 399, 16, _init_ILI9320, _setxy_ili932x, 0);
@@ -1,78 +1,70 @@
-//for  ILI9320   add by huaweiwx@sina.com 2017.1.12
-
-  case ILI9320:
-//	LCD_Write_COM_DATA(0xe5, 0x8000);   
-	LCD_Write_COM_DATA(0x00, 0x0001); //start osc
-	LCD_Write_COM_DATA(0x01, 0x0100); // set Driver Output Control: SS and SM bit   
-	LCD_Write_COM_DATA(0x02, 0x0700); // LCD Driver Waveform Contral.  
-	LCD_Write_COM_DATA(0x03, 0x1030); // set GRAM write direction and BGR=1.  
-//	LCD_Write_COM_DATA(0x03, 0x1018); // set GRAM write direction and BGR=1.  
-	
-	LCD_Write_COM_DATA(0x04, 0x0000); // Resize register  
-	LCD_Write_COM_DATA(0x08, 0x0202); // set the back porch and front porch  
-	LCD_Write_COM_DATA(0x09, 0x0000); // set non-display area refresh cycle ISC[3:0]  
-	LCD_Write_COM_DATA(0x0A, 0x0000); // FMARK function  
-	LCD_Write_COM_DATA(0x0C, (1<<0)); // RGB interface setting  
-	LCD_Write_COM_DATA(0x0D, 0x0000); // Frame marker Position  
-	LCD_Write_COM_DATA(0x0F, 0x0000); // RGB interface polarity 
-
-//	delay(50); // Delay 50ms  
-//	LCD_Write_COM_DATA(0x07, 0x0101);  //Display Contral.
-//	delay(50); // Delay 50ms  
-
-	//*************Power On sequence ****************//  
-	LCD_Write_COM_DATA(0x10, 0x0000);        
-	LCD_Write_COM_DATA(0x11, 0x0007);        
-	LCD_Write_COM_DATA(0x12, 0x0000);        
-	LCD_Write_COM_DATA(0x13, 0x0000);        
-	delay(50); // Delay 50ms  
-
-	LCD_Write_COM_DATA(0x10, (1<<12)|(0<<8)|(1<<7)|(1<<6)|(0<<4)); //Power Control 1.(0x16b0)  
-	LCD_Write_COM_DATA(0x11, 0x0007); // Power Control 2.(0x0001) 
-	delay(10); // Delay 50ms  	
-	LCD_Write_COM_DATA(0x12, (1<<8)|(1<<4)|(0<<0));	//Power Control 3.(0x0138)  
-	delay(10); // Delay 50ms  		
-	LCD_Write_COM_DATA(0x13, 0x0b00); // VDV[4:0] for VCOM amplitude  
-	LCD_Write_COM_DATA(0x29, 0x0000); // 04  VCM[5:0] for VCOMH  
-	delay(10); // Delay 50ms  		
-	LCD_Write_COM_DATA(0x2B, (1<<14)|(1<<4)); // Set Frame Rate  
-
-	//-----Gamma control-----------------------        
-	LCD_Write_COM_DATA(0x30, 0x0000);        
-	LCD_Write_COM_DATA(0x31, 0x0505);        
-	LCD_Write_COM_DATA(0x32, 0x0004);        
-	LCD_Write_COM_DATA(0x35, 0x0006);        
-	LCD_Write_COM_DATA(0x36, 0x0707);        
-	LCD_Write_COM_DATA(0x37, 0x0105);        
-	LCD_Write_COM_DATA(0x38, 0x0002);        
-	LCD_Write_COM_DATA(0x39, 0x0707);        
-	LCD_Write_COM_DATA(0x3C, 0x0704);        
-	LCD_Write_COM_DATA(0x3D, 0x0807);        	
-	//------------------ Set GRAM area ---------------//  
-	LCD_Write_COM_DATA(0x50, 0x0000); //Set X Start.  
-	LCD_Write_COM_DATA(0x51,    239); //Set X End 
-	LCD_Write_COM_DATA(0x52, 0x0000); // Vertical GRAM Start Address  
-	LCD_Write_COM_DATA(0x53,    319); // Vertical GRAM end Address 
-	
-	LCD_Write_COM_DATA(0x60, 0x2700); // Gate Scan Line  
-	LCD_Write_COM_DATA(0x61, 0x0001); // NDL,VLE, REV   
-	LCD_Write_COM_DATA(0x6A, 0x0000); // set scrolling line
-	
-	//-------------- Partial Display Control ---------//  
-	LCD_Write_COM_DATA(0x80, 0x0000);  
-	LCD_Write_COM_DATA(0x81, 0x0000);  
-	LCD_Write_COM_DATA(0x82, 0x0000);  
-	LCD_Write_COM_DATA(0x83, 0x0000);  
-	LCD_Write_COM_DATA(0x84, 0x0000);  
-	LCD_Write_COM_DATA(0x85, 0x0000);
-	
-	//-------------- Panel Control -------------------//  
-	LCD_Write_COM_DATA(0x90, (0<<7)|(16<<0));  
-	LCD_Write_COM_DATA(0x92, 0x0000);  
-	LCD_Write_COM_DATA(0x93, 0x0001);  
-	LCD_Write_COM_DATA(0x95, 0x0110);  
-	LCD_Write_COM_DATA(0x97, (0<<8));  
-	LCD_Write_COM_DATA(0x98, 0x0000);	//Frame Cycle Contral.
-	
-	LCD_Write_COM_DATA(0x07, 0x0173); // 262K color and display ON        
-break;
+// ILI9320
+static const uint8_t _init_ILI9320[]={
+	// for  ILI9320   add by huaweiwx@sina.com 2017.1.12
+//	UTFT_INIT_WORDS|1,	0x00,0xE5, 0x80,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x00, 0x00,0x01,		// start osc
+	UTFT_INIT_WORDS|1,	0x00,0x01, 0x01,0x00,		// set Driver Output Control: SS and SM bit
+	UTFT_INIT_WORDS|1,	0x00,0x02, 0x07,0x00,		// LCD Driver Waveform Contral.
+	UTFT_INIT_WORDS|1,	0x00,0x03, 0x10,0x30,		// set GRAM write direction and BGR=1.
+//	UTFT_INIT_WORDS|1,	0x00,0x03, 0x10,0x18,		// set GRAM write direction and BGR=1.
+	UTFT_INIT_WORDS|1,	0x00,0x04, 0x00,0x00,		// Resize register
+	UTFT_INIT_WORDS|1,	0x00,0x08, 0x02,0x02,		// set the back porch and front porch
+	UTFT_INIT_WORDS|1,	0x00,0x09, 0x00,0x00,		// set non-display area refresh cycle ISC[3:0]
+	UTFT_INIT_WORDS|1,	0x00,0x0A, 0x00,0x00,		// FMARK function
+	UTFT_INIT_WORDS|1,	0x00,0x0C, 0x00,0x01,		// RGB interface setting
+	UTFT_INIT_WORDS|1,	0x00,0x0D, 0x00,0x00,		// Frame marker Position
+	UTFT_INIT_WORDS|1,	0x00,0x0F, 0x00,0x00,		// RGB interface polarity
+//	UTFT_INIT_DELAY, 50,
+//	UTFT_INIT_WORDS|1,	0x00,0x07, 0x01,0x01,		// Display Contral.
+//	UTFT_INIT_DELAY, 50,
+	// *************Power On sequence ***************/
+	UTFT_INIT_WORDS|1,	0x00,0x10, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x00,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x12, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0x00,0x00,
+	UTFT_INIT_DELAY, 50,
+	UTFT_INIT_WORDS|1,	0x00,0x10, 0x10,0xC0,		// Power Control 1.(0x16b0)
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x00,0x07,		// Power Control 2.(0x0001)
+	UTFT_INIT_DELAY, 10,
+	UTFT_INIT_WORDS|1,	0x00,0x12, 0x01,0x10,		// Power Control 3.(0x0138)
+	UTFT_INIT_DELAY, 10,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0x0B,0x00,		// VDV[4:0] for VCOM amplitude
+	UTFT_INIT_WORDS|1,	0x00,0x29, 0x00,0x00,		// 04  VCM[5:0] for VCOMH
+	UTFT_INIT_DELAY, 10,
+	UTFT_INIT_WORDS|1,	0x00,0x2B, 0x40,0x10,		// Set Frame Rate
+	// -----Gamma control-----------------------
+	UTFT_INIT_WORDS|1,	0x00,0x30, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x31, 0x05,0x05,
+	UTFT_INIT_WORDS|1,	0x00,0x32, 0x00,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x35, 0x00,0x06,
+	UTFT_INIT_WORDS|1,	0x00,0x36, 0x07,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x37, 0x01,0x05,
+	UTFT_INIT_WORDS|1,	0x00,0x38, 0x00,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x39, 0x07,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x3C, 0x07,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x3D, 0x08,0x07,
+	// ------------------ Set GRAM area ---------------//
+	UTFT_INIT_WORDS|1,	0x00,0x50, 0x00,0x00,		// Set X Start.
+	UTFT_INIT_WORDS|1,	0x00,0x51, 0x00,0xEF,		// Set X End
+	UTFT_INIT_WORDS|1,	0x00,0x52, 0x00,0x00,		// Vertical GRAM Start Address
+	UTFT_INIT_WORDS|1,	0x00,0x53, 0x01,0x3F,		// Vertical GRAM end Address
+	UTFT_INIT_WORDS|1,	0x00,0x60, 0x27,0x00,		// Gate Scan Line
+	UTFT_INIT_WORDS|1,	0x00,0x61, 0x00,0x01,		// NDL,VLE, REV
+	UTFT_INIT_WORDS|1,	0x00,0x6A, 0x00,0x00,		// set scrolling line
+	// -------------- Partial Display Control ---------//
+	UTFT_INIT_WORDS|1,	0x00,0x80, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x81, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x82, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x83, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x84, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x85, 0x00,0x00,
+	// -------------- Panel Control -------------------//
+	UTFT_INIT_WORDS|1,	0x00,0x90, 0x00,0x10,
+	UTFT_INIT_WORDS|1,	0x00,0x92, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x93, 0x00,0x01,
+	UTFT_INIT_WORDS|1,	0x00,0x95, 0x01,0x10,
+	UTFT_INIT_WORDS|1,	0x00,0x97, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x98, 0x00,0x00,		// Frame Cycle Contral.
+	UTFT_INIT_WORDS|1,	0x00,0x07, 0x01,0x73,		// 262K color and display ON
+	UTFT_INIT_END
+};
@@ -0,0 +1,9 @@
+/*
+  ILI9325C driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9325C, 0, 239, 319, 8, _init_ILI9325C, _setxy_ili932x, 0);
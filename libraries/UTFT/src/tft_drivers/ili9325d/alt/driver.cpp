@@ -0,0 +1,13 @@
+/*
+  ILI9325D driver (alternative 16 bit init, also ILI9328)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9325D_16ALT, 0x9325, 239, 319, 16, _init_ILI9325D_16ALT, _setxy_ili932x, 0);
+
+// The ILI9328 takes the same init and reads back its own ID
+extern const UTFT_Driver _utft_driver_ili9328;
+const UTFT_Driver _utft_driver_ili9328 UTFT_DRIVER_SECTION = {ILI9325D_16ALT, 0x9328, 239, 319, 16, _init_ILI9325D_16ALT, _setxy_ili932x, 0};
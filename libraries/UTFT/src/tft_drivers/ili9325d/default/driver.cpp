@@ -0,0 +1,10 @@
+/*
+  ILI9325D driver (8 and 16 bit)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9325D_8, 0, 239, 319, 8, _init_ILI9325D, _setxy_ili932x, 0);
+UTFT_DRIVER(ILI9325D_16, 0, 239, 319, 16, _init_ILI9325D, _setxy_ili932x, 0);
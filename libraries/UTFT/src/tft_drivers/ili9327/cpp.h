@@ -10,10 +10,6 @@ UTFT_ILI9327::UTFT_ILI9327()
 
 void UTFT_ILI9327::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/ili93287/initlcd.h"
-    }
+	_init_table(_init_ILI9327);
 #include "tft_drivers/common/head2.h"
 }
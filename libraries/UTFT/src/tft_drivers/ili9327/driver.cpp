@@ -0,0 +1,9 @@
+/*
+  ILI9327 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9327, 0, 239, 399, 16, _init_ILI9327, _setxy_ili9327, 0);
@@ -1,63 +1,20 @@
-case ILI9327:
-	LCD_Write_COM(0xE9);
-	LCD_Write_DATA(0x00,0x20);
-	LCD_Write_COM(0x11); //Exit Sleep
-	delay(100);
-	LCD_Write_COM(0xD1);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x71);
-	LCD_Write_DATA(0x00,0x19);
-	LCD_Write_COM(0xD0);
-	LCD_Write_DATA(0x00,0x07);
-	LCD_Write_DATA(0x00,0x01);
-	LCD_Write_DATA(0x00,0x08);
-	LCD_Write_COM(0x36);
-	LCD_Write_DATA(0x00,0x48);
-	LCD_Write_COM(0x3A);
-	LCD_Write_DATA(0x00,0x05);
-	LCD_Write_COM(0xC1);
-	LCD_Write_DATA(0x00,0x10);
-	LCD_Write_DATA(0x00,0x10);
-	LCD_Write_DATA(0x00,0x02);
-	LCD_Write_DATA(0x00,0x02);
-	LCD_Write_COM(0xC0); //Set Default Gamma
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x35);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x01);
-	LCD_Write_DATA(0x00,0x02);
-	LCD_Write_COM(0xC5); //Set frame rate
-	LCD_Write_DATA(0x00,0x04);
-	LCD_Write_COM(0xD2); //power setting
-	LCD_Write_DATA(0x00,0x01);
-	LCD_Write_DATA(0x00,0x44);
-	LCD_Write_COM(0xC8); //Set Gamma
-	LCD_Write_DATA(0x00,0x04);
-	LCD_Write_DATA(0x00,0x67);
-	LCD_Write_DATA(0x00,0x35);
-	LCD_Write_DATA(0x00,0x04);
-	LCD_Write_DATA(0x00,0x08);
-	LCD_Write_DATA(0x00,0x06);
-	LCD_Write_DATA(0x00,0x24);
-	LCD_Write_DATA(0x00,0x01);
-	LCD_Write_DATA(0x00,0x37);
-	LCD_Write_DATA(0x00,0x40);
-	LCD_Write_DATA(0x00,0x03);
-	LCD_Write_DATA(0x00,0x10);
-	LCD_Write_DATA(0x00,0x08);
-	LCD_Write_DATA(0x00,0x80);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_COM(0x2A); 
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0xeF);
-	LCD_Write_COM(0x2B); 
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x00);
-	LCD_Write_DATA(0x00,0x01);
-	LCD_Write_DATA(0x00,0x8F);
-	LCD_Write_COM(0x29); //display on      
-	LCD_Write_COM(0x2C); //display on
-	break;
+// ILI9327
+static const uint8_t _init_ILI9327[]={
+	UTFT_INIT_WORDS|1,	0x00,0xE9, 0x00,0x20,
+	0,	0x11,		// Exit Sleep
+	UTFT_INIT_DELAY, 100,
+	UTFT_INIT_WORDS|3,	0x00,0xD1, 0x00,0x00, 0x00,0x71, 0x00,0x19,
+	UTFT_INIT_WORDS|3,	0x00,0xD0, 0x00,0x07, 0x00,0x01, 0x00,0x08,
+	UTFT_INIT_WORDS|1,	0x00,0x36, 0x00,0x48,
+	UTFT_INIT_WORDS|1,	0x00,0x3A, 0x00,0x05,
+	UTFT_INIT_WORDS|4,	0x00,0xC1, 0x00,0x10, 0x00,0x10, 0x00,0x02, 0x00,0x02,
+	UTFT_INIT_WORDS|6,	0x00,0xC0, 0x00,0x00, 0x00,0x35, 0x00,0x00, 0x00,0x00, 0x00,0x01, 0x00,0x02,		// Set Default Gamma
+	UTFT_INIT_WORDS|1,	0x00,0xC5, 0x00,0x04,		// Set frame rate
+	UTFT_INIT_WORDS|2,	0x00,0xD2, 0x00,0x01, 0x00,0x44,		// power setting
+	UTFT_INIT_WORDS|15,	0x00,0xC8, 0x00,0x04, 0x00,0x67, 0x00,0x35, 0x00,0x04, 0x00,0x08, 0x00,0x06, 0x00,0x24, 0x00,0x01, 0x00,0x37, 0x00,0x40, 0x00,0x03, 0x00,0x10, 0x00,0x08, 0x00,0x80, 0x00,0x00,		// Set Gamma
+	UTFT_INIT_WORDS|4,	0x00,0x2A, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0xEF,
+	UTFT_INIT_WORDS|4,	0x00,0x2B, 0x00,0x00, 0x00,0x00, 0x00,0x01, 0x00,0x8F,
+	0,	0x29,		// display on
+	0,	0x2C,		// display on
+	UTFT_INIT_END
+};
@@ -0,0 +1,21 @@
+/*
+  ILI9327 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_ili9327(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM(0x2a);
+	lcd->LCD_Write_DATA(0x00,x1>>8);
+	lcd->LCD_Write_DATA(0x00,x1);
+	lcd->LCD_Write_DATA(0x00,x2>>8);
+	lcd->LCD_Write_DATA(0x00,x2);
+	lcd->LCD_Write_COM(0x2b);
+	lcd->LCD_Write_DATA(0x00,y1>>8);
+	lcd->LCD_Write_DATA(0x00,y1);
+	lcd->LCD_Write_DATA(0x00,y2>>8);
+	lcd->LCD_Write_DATA(0x00,y2);
+	lcd->LCD_Write_COM(0x2c);
+}
@@ -11,11 +11,7 @@ UTFT_ILI9341::UTFT_ILI9341()
 
 void UTFT_ILI9341::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/ili9341/initlcd.h"
-    }
+	_init_table(_init_ILI9341_16);
 
 #include "tft_drivers/common/head2.h"
 }
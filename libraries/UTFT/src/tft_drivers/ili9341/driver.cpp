@@ -0,0 +1,9 @@
+/*
+  ILI9341 driver (16 bit)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9341_16, 0x9341, 239, 319, 16, _init_ILI9341_16, _setxy_dcs, 0);
@@ -0,0 +1,9 @@
+/*
+  ILI9341 driver (4 pin serial)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9341_S4P, 0, 239, 319, SERIAL_4PIN, _init_ILI9341_S4P, _setxy_dcs, 0);
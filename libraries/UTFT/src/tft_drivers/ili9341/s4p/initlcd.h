@@ -1,58 +1,27 @@
-case ILI9341_S4P:
-	LCD_Write_COM(0x11);//sleep out 
-	delay(20);
-  //LCD_Write_COM(0x01); //reset
-  //delay(15);
-  LCD_Write_COM(0x28); //display off
-  delay(5);
-  LCD_Write_COM(0xCF); //power control b
-  LCD_Write_DATA(0x00);
-  LCD_Write_DATA(0x83); //83 81 AA
-  LCD_Write_DATA(0x30);
-  LCD_Write_COM(0xED); //power on seq control
-  LCD_Write_DATA(0x64); //64 67
-  LCD_Write_DATA(0x03);
-  LCD_Write_DATA(0x12);
-  LCD_Write_DATA(0x81);
-  LCD_Write_COM(0xE8); //timing control a
-  LCD_Write_DATA(0x85);
-  LCD_Write_DATA(0x01);
-  LCD_Write_DATA(0x79); //79 78
-  LCD_Write_COM(0xCB); //power control a
-  LCD_Write_DATA(0x39);
-  LCD_Write_DATA(0X2C);
-  LCD_Write_DATA(0x00);
-  LCD_Write_DATA(0x34);
-  LCD_Write_DATA(0x02);
-  LCD_Write_COM(0xF7); //pump ratio control
-  LCD_Write_DATA(0x20);
-  LCD_Write_COM(0xEA); //timing control b
-  LCD_Write_DATA(0x00);
-  LCD_Write_DATA(0x00);
-  LCD_Write_COM(0xC0); //power control 2
-  LCD_Write_DATA(0x26); //26 25
-  LCD_Write_COM(0xC1); //power control 2
-  LCD_Write_DATA(0x11);
-  LCD_Write_COM(0xC5); //vcom control 1
-  LCD_Write_DATA(0x35);
-  LCD_Write_DATA(0x3E);
-  LCD_Write_COM(0xC7); //vcom control 2
-  LCD_Write_DATA(0xBE); //BE 94
-  LCD_Write_COM(0xB1); //frame control
-  LCD_Write_DATA(0x00);
-  LCD_Write_DATA(0x1B); //1B 70
-  LCD_Write_COM(0xB6); //display control
-  LCD_Write_DATA(0x0A);
-  LCD_Write_DATA(0x82);
-  LCD_Write_DATA(0x27);
-  LCD_Write_DATA(0x00);
-  LCD_Write_COM(0xB7); //emtry mode
-  LCD_Write_DATA(0x07);
-  LCD_Write_COM(0x3A); //pixel format
-  LCD_Write_DATA(0x55); //16bit
-  LCD_Write_COM(0x36); //mem access
-  LCD_Write_DATA((1<<3)|(1<<6));
-  //LCD_Write_DATA((1<<3)|(1<<7)); //rotate 180
-  LCD_Write_COM(0x29); //display on
-  delay(5);
-	break;
+// ILI9341, serial 4 pin
+static const uint8_t _init_ILI9341_S4P[]={
+	0,	0x11,		// sleep out
+	UTFT_INIT_DELAY, 20,
+//	0,	0x01,		// reset
+//	UTFT_INIT_DELAY, 15,
+	0,	0x28,		// display off
+	UTFT_INIT_DELAY, 5,
+	3,	0xCF, 0x00, 0x83, 0x30,		// power control b
+	4,	0xED, 0x64, 0x03, 0x12, 0x81,		// power on seq control
+	3,	0xE8, 0x85, 0x01, 0x79,		// timing control a
+	5,	0xCB, 0x39, 0x2C, 0x00, 0x34, 0x02,		// power control a
+	1,	0xF7, 0x20,		// pump ratio control
+	2,	0xEA, 0x00, 0x00,		// timing control b
+	1,	0xC0, 0x26,		// power control 2
+	1,	0xC1, 0x11,		// power control 2
+	2,	0xC5, 0x35, 0x3E,		// vcom control 1
+	1,	0xC7, 0xBE,		// vcom control 2
+	2,	0xB1, 0x00, 0x1B,		// frame control
+	4,	0xB6, 0x0A, 0x82, 0x27, 0x00,		// display control
+	1,	0xB7, 0x07,		// emtry mode
+	1,	0x3A, 0x55,		// pixel format
+	1,	0x36, 0x48,		// mem access
+	0,	0x29,		// display on
+	UTFT_INIT_DELAY, 5,
+	UTFT_INIT_END
+};
@@ -0,0 +1,9 @@
+/*
+  ILI9341 driver (5 pin serial)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9341_S5P, 0, 239, 319, SERIAL_5PIN, _init_ILI9341_S5P, _setxy_dcs, 0);
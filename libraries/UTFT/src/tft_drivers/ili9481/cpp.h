@@ -11,11 +11,7 @@ UTFT_ILI9481::UTFT_ILI9481()
 
 void UTFT_ILI9481::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/ili9481/initlcd.h"
-    }
+	_init_table(_init_ILI9481);
 
 #include "tft_drivers/common/head2.h"
 }
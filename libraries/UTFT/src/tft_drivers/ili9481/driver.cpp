@@ -0,0 +1,9 @@
+/*
+  ILI9481 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9481, 0x9481, 319, 479, 16, _init_ILI9481, _setxy_dcs, 0);
@@ -1,62 +1,18 @@
-case ILI9481:
-	LCD_Write_COM(0x11);
-	delay(20);
-	LCD_Write_COM(0xD0);
-	LCD_Write_DATA(0x07);
-	LCD_Write_DATA(0x42);
-	LCD_Write_DATA(0x18);
-
-	LCD_Write_COM(0xD1);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x07);
-	LCD_Write_DATA(0x10);
-
-	LCD_Write_COM(0xD2);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0x02);
-
-	LCD_Write_COM(0xC0);
-	LCD_Write_DATA(0x10);
-	LCD_Write_DATA(0x3B);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x02);
-	LCD_Write_DATA(0x11);
-
-	LCD_Write_COM(0xC5);
-	LCD_Write_DATA(0x03);
-
-	LCD_Write_COM(0xC8);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x32);
-	LCD_Write_DATA(0x36);
-	LCD_Write_DATA(0x45);
-	LCD_Write_DATA(0x06);
-	LCD_Write_DATA(0x16);
-	LCD_Write_DATA(0x37);
-	LCD_Write_DATA(0x75);
-	LCD_Write_DATA(0x77);
-	LCD_Write_DATA(0x54);
-	LCD_Write_DATA(0x0C);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0x36);
-	LCD_Write_DATA(0x0A);
-
-
-	LCD_Write_COM(0x3A);
-	LCD_Write_DATA(0x55);
-
-	LCD_Write_COM(0x2A);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0x3F);
-
-	LCD_Write_COM(0x2B);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0xE0);
-	delay(120);
-	LCD_Write_COM(0x29);
-	break;
+// ILI9481
+static const uint8_t _init_ILI9481[]={
+	0,	0x11,
+	UTFT_INIT_DELAY, 20,
+	3,	0xD0, 0x07, 0x42, 0x18,
+	3,	0xD1, 0x00, 0x07, 0x10,
+	2,	0xD2, 0x01, 0x02,
+	5,	0xC0, 0x10, 0x3B, 0x00, 0x02, 0x11,
+	1,	0xC5, 0x03,
+	12,	0xC8, 0x00, 0x32, 0x36, 0x45, 0x06, 0x16, 0x37, 0x75, 0x77, 0x54, 0x0C, 0x00,
+	1,	0x36, 0x0A,
+	1,	0x3A, 0x55,
+	4,	0x2A, 0x00, 0x00, 0x01, 0x3F,
+	4,	0x2B, 0x00, 0x00, 0x01, 0xE0,
+	UTFT_INIT_DELAY, 120,
+	0,	0x29,
+	UTFT_INIT_END
+};
@@ -11,11 +11,7 @@ UTFT_ILI9486::UTFT_ILI9486()
 
 void UTFT_ILI9486::Init(byte orientation){
 #include "tft_drivers/common/head1.h"
-	switch(display_model)
-	{
-
-#include "tft_drivers/ili9486/initlcd.h"
-    }
+	_init_table(_init_ILI9486);
 
 #include "tft_drivers/common/head2.h"
 }
@@ -0,0 +1,9 @@
+/*
+  ILI9486 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ILI9486, 0x9486, 319, 479, 16, _init_ILI9486, _setxy_ili9486, 0);
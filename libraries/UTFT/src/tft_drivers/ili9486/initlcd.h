@@ -1,106 +1,26 @@
-case ILI9486:
-    delay(50);
-	LCD_Write_COM(0x11);		// Sleep OUT
-	delay(50);
- 
-	LCD_Write_COM(0xF2);		// ?????
-	LCD_Write_DATA(0x1C);
-	LCD_Write_DATA(0xA3);
-	LCD_Write_DATA(0x32);
-	LCD_Write_DATA(0x02);
-	LCD_Write_DATA(0xb2);
-	LCD_Write_DATA(0x12);
-	LCD_Write_DATA(0xFF);
-	LCD_Write_DATA(0x12);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xF1);		// ?????
-	LCD_Write_DATA(0x36);
-	LCD_Write_DATA(0xA4);
-
-	LCD_Write_COM(0xF8);		// ?????
-	LCD_Write_DATA(0x21);
-	LCD_Write_DATA(0x04);
-
-	LCD_Write_COM(0xF9);		// ?????
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x08);
-
-	LCD_Write_COM(0xC0);		// Power Control 1
-	LCD_Write_DATA(0x0d);
-	LCD_Write_DATA(0x0d);
-
-	LCD_Write_COM(0xC1);		// Power Control 2
-	LCD_Write_DATA(0x43);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xC2);		// Power Control 3
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xC5);		// VCOM Control
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x48);
-
-	LCD_Write_COM(0xB6);		// Display Function Control
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x22);		// 0x42 = Rotate display 180 deg.
-	LCD_Write_DATA(0x3B);
-
-	LCD_Write_COM(0xE0);		// PGAMCTRL (Positive Gamma Control)
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x24);
-	LCD_Write_DATA(0x1c);
-	LCD_Write_DATA(0x0a);
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x08);
-	LCD_Write_DATA(0x43);
-	LCD_Write_DATA(0x88);
-	LCD_Write_DATA(0x32);
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x10);
-	LCD_Write_DATA(0x06);
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x07);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xE1);		// NGAMCTRL (Negative Gamma Control)
-	LCD_Write_DATA(0x0F);
-	LCD_Write_DATA(0x38);
-	LCD_Write_DATA(0x30);
-	LCD_Write_DATA(0x09);
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x0f);
-	LCD_Write_DATA(0x4e);
-	LCD_Write_DATA(0x77);
-	LCD_Write_DATA(0x3c);
-	LCD_Write_DATA(0x07);
-	LCD_Write_DATA(0x10);
-	LCD_Write_DATA(0x05);
-	LCD_Write_DATA(0x23);
-	LCD_Write_DATA(0x1b);
-	LCD_Write_DATA(0x00); 
-
-	LCD_Write_COM(0x20);		// Display Inversion OFF
-	LCD_Write_DATA(0x00);//C8 	 
-
-	LCD_Write_COM(0x36);		// Memory Access Control
-	LCD_Write_DATA(0x0A);
-
-	LCD_Write_COM(0x3A);		// Interface Pixel Format
-	LCD_Write_DATA(0x55); 
-
-	LCD_Write_COM(0x2A);		// Column Addess Set
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0xDF);
-
-	LCD_Write_COM(0x2B);		// Page Address Set
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0x3f);	 
-	delay(50);
-	LCD_Write_COM(0x29);		// Display ON
-	LCD_Write_COM(0x2C);		// Memory Write
-	break;
+// ILI9486
+static const uint8_t _init_ILI9486[]={
+	UTFT_INIT_DELAY, 50,
+	0,	0x11,		// Sleep OUT
+	UTFT_INIT_DELAY, 50,
+	9,	0xF2, 0x1C, 0xA3, 0x32, 0x02, 0xB2, 0x12, 0xFF, 0x12, 0x00,		// ?????
+	2,	0xF1, 0x36, 0xA4,		// ?????
+	2,	0xF8, 0x21, 0x04,		// ?????
+	2,	0xF9, 0x00, 0x08,		// ?????
+	2,	0xC0, 0x0D, 0x0D,		// Power Control 1
+	2,	0xC1, 0x43, 0x00,		// Power Control 2
+	1,	0xC2, 0x00,		// Power Control 3
+	2,	0xC5, 0x00, 0x48,		// VCOM Control
+	3,	0xB6, 0x00, 0x22, 0x3B,		// Display Function Control
+	15,	0xE0, 0x0F, 0x24, 0x1C, 0x0A, 0x0F, 0x08, 0x43, 0x88, 0x32, 0x0F, 0x10, 0x06, 0x0F, 0x07, 0x00,		// PGAMCTRL (Positive Gamma Control)
+	15,	0xE1, 0x0F, 0x38, 0x30, 0x09, 0x0F, 0x0F, 0x4E, 0x77, 0x3C, 0x07, 0x10, 0x05, 0x23, 0x1B, 0x00,		// NGAMCTRL (Negative Gamma Control)
+	1,	0x20, 0x00,		// Display Inversion OFF
+	1,	0x36, 0x0A,		// Memory Access Control
+	1,	0x3A, 0x55,		// Interface Pixel Format
+	4,	0x2A, 0x00, 0x00, 0x01, 0xDF,		// Column Addess Set
+	4,	0x2B, 0x00, 0x00, 0x01, 0x3F,		// Page Address Set
+	UTFT_INIT_DELAY, 50,
+	0,	0x29,		// Display ON
+	0,	0x2C,		// Memory Write
+	UTFT_INIT_END
+};
@@ -0,0 +1,21 @@
+/*
+  ILI9486 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_ili9486(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM(0x2a);
+	lcd->LCD_Write_DATA(x1>>8);
+	lcd->LCD_Write_DATA(x1&0xff);
+	lcd->LCD_Write_DATA(x2>>8);
+	lcd->LCD_Write_DATA(x2&0xff);
+	lcd->LCD_Write_COM(0x2b);
+	lcd->LCD_Write_DATA(y1>>8);
+	lcd->LCD_Write_DATA(y1&0xff);
+	lcd->LCD_Write_DATA(y2>>8);
+	lcd->LCD_Write_DATA(y2&0xff);
+	lcd->LCD_Write_COM(0x2c);
+}
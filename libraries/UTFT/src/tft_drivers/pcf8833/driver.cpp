@@ -0,0 +1,9 @@
+/*
+  PCF8833 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(PCF8833, 0, 127, 127, SERIAL_5PIN, _init_PCF8833, _setxy_pcf8833, 0);
@@ -1,30 +1,19 @@
-case PCF8833:
-	LCD_Write_COM(0x01);
-	LCD_Write_COM(0x25);
-	LCD_Write_DATA(0x40);
-	LCD_Write_COM(0x11);
-	delay(10);
-	LCD_Write_COM(0x20);
-	LCD_Write_COM(0x38);
-	LCD_Write_COM(0x29);
-	LCD_Write_COM(0x13);
-	LCD_Write_COM(0x36);
-	LCD_Write_DATA(0x60);
-	LCD_Write_COM(0x3A);
-	LCD_Write_DATA(0x05);
-	LCD_Write_COM(0x2A);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x7F);
-	LCD_Write_COM(0xB4);
-	LCD_Write_DATA(0x03);
-	LCD_Write_DATA(0x08);
-	LCD_Write_DATA(0x0b);
-	LCD_Write_DATA(0x0e);
-	LCD_Write_COM(0xBA);
-	LCD_Write_DATA(0x07);
-	LCD_Write_DATA(0x0D);
-	LCD_Write_COM(0x2B);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x7F);
-	LCD_Write_COM(0x2C);
-	break;
+// PCF8833
+static const uint8_t _init_PCF8833[]={
+	0,	0x01,
+	1,	0x25, 0x40,
+	0,	0x11,
+	UTFT_INIT_DELAY, 10,
+	0,	0x20,
+	0,	0x38,
+	0,	0x29,
+	0,	0x13,
+	1,	0x36, 0x60,
+	1,	0x3A, 0x05,
+	2,	0x2A, 0x00, 0x7F,
+	4,	0xB4, 0x03, 0x08, 0x0B, 0x0E,
+	2,	0xBA, 0x07, 0x0D,
+	2,	0x2B, 0x00, 0x7F,
+	0,	0x2C,
+	UTFT_INIT_END
+};
@@ -0,0 +1,17 @@
+/*
+  PCF8833 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_pcf8833(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM(0x2a);
+	lcd->LCD_Write_DATA(x1);
+	lcd->LCD_Write_DATA(x2);
+	lcd->LCD_Write_COM(0x2b);
+	lcd->LCD_Write_DATA(y1);
+	lcd->LCD_Write_DATA(y2);
+	lcd->LCD_Write_COM(0x2c);
+}
@@ -0,0 +1,9 @@
+/*
+  R61581 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(R61581, 0, 319, 479, 16, _init_R61581, _setxy_dcs, 0);
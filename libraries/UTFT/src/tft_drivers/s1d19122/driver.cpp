@@ -0,0 +1,21 @@
+/*
+  S1D19122 driver
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+// RGB lookup table
+static void _init_done_s1d19122(UTFT *lcd)
+{
+	for (int i=0; i<32; i++)
+		lcd->LCD_Write_DATA(i*2);	// R
+	for (int i=0; i<64; i++)
+		lcd->LCD_Write_DATA(i);		// G
+	for (int i=0; i<32; i++)
+		lcd->LCD_Write_DATA(i*2);	// B
+}
+
+UTFT_DRIVER(S1D19122, 0, 239, 319, 16, _init_S1D19122, _setxy_dcs, _init_done_s1d19122);
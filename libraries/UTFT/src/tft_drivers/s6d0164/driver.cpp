@@ -0,0 +1,9 @@
+/*
+  S6D0164 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(S6D0164, 0, 175, 219, 8, _init_S6D0164, _setxy_s6d0164, 0);
@@ -0,0 +1,17 @@
+/*
+  S6D0164 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_s6d0164(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x36,x2);
+	lcd->LCD_Write_COM_DATA(0x37,x1);
+	lcd->LCD_Write_COM_DATA(0x38,y2);
+	lcd->LCD_Write_COM_DATA(0x39,y1);
+	lcd->LCD_Write_COM_DATA(0x20,x1);
+	lcd->LCD_Write_COM_DATA(0x21,y1);
+	lcd->LCD_Write_COM(0x22);
+}
@@ -0,0 +1,10 @@
+/*
+  S6D1121 driver (8 and 16 bit)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(S6D1121_8, 0, 239, 319, 8, _init_S6D1121, _setxy_s6d1121, 0);
+UTFT_DRIVER(S6D1121_16, 0, 239, 319, 16, _init_S6D1121, _setxy_s6d1121, 0);
@@ -1,47 +1,48 @@
-case S6D1121_8:
-case S6D1121_16:
-	LCD_Write_COM_DATA(0x11,0x2004);		
-	LCD_Write_COM_DATA(0x13,0xCC00);		
-	LCD_Write_COM_DATA(0x15,0x2600);	
-	LCD_Write_COM_DATA(0x14,0x252A);	
-	LCD_Write_COM_DATA(0x12,0x0033);		
-	LCD_Write_COM_DATA(0x13,0xCC04);		
-	LCD_Write_COM_DATA(0x13,0xCC06);		
-	LCD_Write_COM_DATA(0x13,0xCC4F);		
-	LCD_Write_COM_DATA(0x13,0x674F);
-	LCD_Write_COM_DATA(0x11,0x2003);
-	LCD_Write_COM_DATA(0x30,0x2609);		
-	LCD_Write_COM_DATA(0x31,0x242C);		
-	LCD_Write_COM_DATA(0x32,0x1F23);		
-	LCD_Write_COM_DATA(0x33,0x2425);		
-	LCD_Write_COM_DATA(0x34,0x2226);		
-	LCD_Write_COM_DATA(0x35,0x2523);		
-	LCD_Write_COM_DATA(0x36,0x1C1A);		
-	LCD_Write_COM_DATA(0x37,0x131D);		
-	LCD_Write_COM_DATA(0x38,0x0B11);		
-	LCD_Write_COM_DATA(0x39,0x1210);		
-	LCD_Write_COM_DATA(0x3A,0x1315);		
-	LCD_Write_COM_DATA(0x3B,0x3619);		
-	LCD_Write_COM_DATA(0x3C,0x0D00);		
-	LCD_Write_COM_DATA(0x3D,0x000D);		
-	LCD_Write_COM_DATA(0x16,0x0007);		
-	LCD_Write_COM_DATA(0x02,0x0013);		
-	LCD_Write_COM_DATA(0x03,0x0003);		
-	LCD_Write_COM_DATA(0x01,0x0127);		
-	LCD_Write_COM_DATA(0x08,0x0303);		
-	LCD_Write_COM_DATA(0x0A,0x000B);		
-	LCD_Write_COM_DATA(0x0B,0x0003);   
-	LCD_Write_COM_DATA(0x0C,0x0000);   
-	LCD_Write_COM_DATA(0x41,0x0000);    
-	LCD_Write_COM_DATA(0x50,0x0000);   
-	LCD_Write_COM_DATA(0x60,0x0005);    
-	LCD_Write_COM_DATA(0x70,0x000B);    
-	LCD_Write_COM_DATA(0x71,0x0000);    
-	LCD_Write_COM_DATA(0x78,0x0000);    
-	LCD_Write_COM_DATA(0x7A,0x0000);   
-	LCD_Write_COM_DATA(0x79,0x0007);		
-	LCD_Write_COM_DATA(0x07,0x0051);   
-	LCD_Write_COM_DATA(0x07,0x0053);		
-	LCD_Write_COM_DATA(0x79,0x0000);
-	LCD_Write_COM(0x22);
-	break;
+// S6D1121, 8 and 16 bit
+static const uint8_t _init_S6D1121[]={
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x20,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0xCC,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x15, 0x26,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x14, 0x25,0x2A,
+	UTFT_INIT_WORDS|1,	0x00,0x12, 0x00,0x33,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0xCC,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0xCC,0x06,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0xCC,0x4F,
+	UTFT_INIT_WORDS|1,	0x00,0x13, 0x67,0x4F,
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x20,0x03,
+	UTFT_INIT_WORDS|1,	0x00,0x30, 0x26,0x09,
+	UTFT_INIT_WORDS|1,	0x00,0x31, 0x24,0x2C,
+	UTFT_INIT_WORDS|1,	0x00,0x32, 0x1F,0x23,
+	UTFT_INIT_WORDS|1,	0x00,0x33, 0x24,0x25,
+	UTFT_INIT_WORDS|1,	0x00,0x34, 0x22,0x26,
+	UTFT_INIT_WORDS|1,	0x00,0x35, 0x25,0x23,
+	UTFT_INIT_WORDS|1,	0x00,0x36, 0x1C,0x1A,
+	UTFT_INIT_WORDS|1,	0x00,0x37, 0x13,0x1D,
+	UTFT_INIT_WORDS|1,	0x00,0x38, 0x0B,0x11,
+	UTFT_INIT_WORDS|1,	0x00,0x39, 0x12,0x10,
+	UTFT_INIT_WORDS|1,	0x00,0x3A, 0x13,0x15,
+	UTFT_INIT_WORDS|1,	0x00,0x3B, 0x36,0x19,
+	UTFT_INIT_WORDS|1,	0x00,0x3C, 0x0D,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x3D, 0x00,0x0D,
+	UTFT_INIT_WORDS|1,	0x00,0x16, 0x00,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x02, 0x00,0x13,
+	UTFT_INIT_WORDS|1,	0x00,0x03, 0x00,0x03,
+	UTFT_INIT_WORDS|1,	0x00,0x01, 0x01,0x27,
+	UTFT_INIT_WORDS|1,	0x00,0x08, 0x03,0x03,
+	UTFT_INIT_WORDS|1,	0x00,0x0A, 0x00,0x0B,
+	UTFT_INIT_WORDS|1,	0x00,0x0B, 0x00,0x03,
+	UTFT_INIT_WORDS|1,	0x00,0x0C, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x41, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x50, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x60, 0x00,0x05,
+	UTFT_INIT_WORDS|1,	0x00,0x70, 0x00,0x0B,
+	UTFT_INIT_WORDS|1,	0x00,0x71, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x78, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x7A, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x79, 0x00,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x07, 0x00,0x51,
+	UTFT_INIT_WORDS|1,	0x00,0x07, 0x00,0x53,
+	UTFT_INIT_WORDS|1,	0x00,0x79, 0x00,0x00,
+	0,	0x22,
+	UTFT_INIT_END
+};
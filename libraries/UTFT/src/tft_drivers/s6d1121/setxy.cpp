@@ -0,0 +1,16 @@
+/*
+  S6D1121 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_s6d1121(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x46,(x2 << 8) | x1);
+	lcd->LCD_Write_COM_DATA(0x47,y2);
+	lcd->LCD_Write_COM_DATA(0x48,y1);
+	lcd->LCD_Write_COM_DATA(0x20,x1);
+	lcd->LCD_Write_COM_DATA(0x21,y1);
+	lcd->LCD_Write_COM(0x22);
+}
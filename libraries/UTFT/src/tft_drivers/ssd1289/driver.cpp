@@ -0,0 +1,11 @@
+/*
+  SSD1289 driver (16 bit, 8 bit and latched 16 bit)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(SSD1289, 0x8989, 239, 319, 16, _init_SSD1289, _setxy_ssd1289, 0);
+UTFT_DRIVER(SSD1289_8, 0, 239, 319, 8, _init_SSD1289, _setxy_ssd1289, 0);
+UTFT_DRIVER(SSD1289LATCHED, 0, 239, 319, LATCHED_16, _init_SSD1289, _setxy_ssd1289, 0);
@@ -1,46 +1,46 @@
-case SSD1289:
-case SSD1289_8:
-case SSD1289LATCHED:
-	LCD_Write_COM_DATA(0x00,0x0001);
-	LCD_Write_COM_DATA(0x03,0xA8A4);
-	LCD_Write_COM_DATA(0x0C,0x0000);
-	LCD_Write_COM_DATA(0x0D,0x080C);
-	LCD_Write_COM_DATA(0x0E,0x2B00);
-	LCD_Write_COM_DATA(0x1E,0x00B7);
-	LCD_Write_COM_DATA(0x01,0x2B3F);
-	LCD_Write_COM_DATA(0x02,0x0600);
-	LCD_Write_COM_DATA(0x10,0x0000);
-	LCD_Write_COM_DATA(0x11,0x6070);
-	LCD_Write_COM_DATA(0x05,0x0000);
-	LCD_Write_COM_DATA(0x06,0x0000);
-	LCD_Write_COM_DATA(0x16,0xEF1C);
-	LCD_Write_COM_DATA(0x17,0x0003);
-	LCD_Write_COM_DATA(0x07,0x0233);
-	LCD_Write_COM_DATA(0x0B,0x0000);
-	LCD_Write_COM_DATA(0x0F,0x0000);
-	LCD_Write_COM_DATA(0x41,0x0000);
-	LCD_Write_COM_DATA(0x42,0x0000);
-	LCD_Write_COM_DATA(0x48,0x0000);
-	LCD_Write_COM_DATA(0x49,0x013F);
-	LCD_Write_COM_DATA(0x4A,0x0000);
-	LCD_Write_COM_DATA(0x4B,0x0000);
-	LCD_Write_COM_DATA(0x44,0xEF00);
-	LCD_Write_COM_DATA(0x45,0x0000);
-	LCD_Write_COM_DATA(0x46,0x013F);
-	LCD_Write_COM_DATA(0x30,0x0707);
-	LCD_Write_COM_DATA(0x31,0x0204);
-	LCD_Write_COM_DATA(0x32,0x0204);
-	LCD_Write_COM_DATA(0x33,0x0502);
-	LCD_Write_COM_DATA(0x34,0x0507);
-	LCD_Write_COM_DATA(0x35,0x0204);
-	LCD_Write_COM_DATA(0x36,0x0204);
-	LCD_Write_COM_DATA(0x37,0x0502);
-	LCD_Write_COM_DATA(0x3A,0x0302);
-	LCD_Write_COM_DATA(0x3B,0x0302);
-	LCD_Write_COM_DATA(0x23,0x0000);
-	LCD_Write_COM_DATA(0x24,0x0000);
-	LCD_Write_COM_DATA(0x25,0x8000);
-	LCD_Write_COM_DATA(0x4f,0x0000);
-	LCD_Write_COM_DATA(0x4e,0x0000);
-	LCD_Write_COM(0x22);   
-	break;
+// SSD1289, 16 bit, 8 bit and latched
+static const uint8_t _init_SSD1289[]={
+	UTFT_INIT_WORDS|1,	0x00,0x00, 0x00,0x01,
+	UTFT_INIT_WORDS|1,	0x00,0x03, 0xA8,0xA4,
+	UTFT_INIT_WORDS|1,	0x00,0x0C, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x0D, 0x08,0x0C,
+	UTFT_INIT_WORDS|1,	0x00,0x0E, 0x2B,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x1E, 0x00,0xB7,
+	UTFT_INIT_WORDS|1,	0x00,0x01, 0x2B,0x3F,
+	UTFT_INIT_WORDS|1,	0x00,0x02, 0x06,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x10, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x11, 0x60,0x70,
+	UTFT_INIT_WORDS|1,	0x00,0x05, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x06, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x16, 0xEF,0x1C,
+	UTFT_INIT_WORDS|1,	0x00,0x17, 0x00,0x03,
+	UTFT_INIT_WORDS|1,	0x00,0x07, 0x02,0x33,
+	UTFT_INIT_WORDS|1,	0x00,0x0B, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x0F, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x41, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x42, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x48, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x49, 0x01,0x3F,
+	UTFT_INIT_WORDS|1,	0x00,0x4A, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x4B, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x44, 0xEF,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x45, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x46, 0x01,0x3F,
+	UTFT_INIT_WORDS|1,	0x00,0x30, 0x07,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x31, 0x02,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x32, 0x02,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x33, 0x05,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x34, 0x05,0x07,
+	UTFT_INIT_WORDS|1,	0x00,0x35, 0x02,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x36, 0x02,0x04,
+	UTFT_INIT_WORDS|1,	0x00,0x37, 0x05,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x3A, 0x03,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x3B, 0x03,0x02,
+	UTFT_INIT_WORDS|1,	0x00,0x23, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x24, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x25, 0x80,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x4F, 0x00,0x00,
+	UTFT_INIT_WORDS|1,	0x00,0x4E, 0x00,0x00,
+	0,	0x22,
+	UTFT_INIT_END
+};
@@ -0,0 +1,16 @@
+/*
+  SSD1289 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+void _setxy_ssd1289(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	lcd->LCD_Write_COM_DATA(0x44,(x2<<8)+x1);
+	lcd->LCD_Write_COM_DATA(0x45,y1);
+	lcd->LCD_Write_COM_DATA(0x46,y2);
+	lcd->LCD_Write_COM_DATA(0x4e,x1);
+	lcd->LCD_Write_COM_DATA(0x4f,y1);
+	lcd->LCD_Write_COM(0x22);
+}
@@ -0,0 +1,16 @@
+/*
+  SSD1963 driver (480x272)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+// Display on, once the whole panel is the window
+static void _init_done_ssd1963_480(UTFT *lcd)
+{
+	lcd->setXY(0, 0, 479, 271);
+	lcd->_init_table(_init_SSD1963_480_ON);
+}
+
+UTFT_DRIVER(SSD1963_480, 0, 271, 479, 16, _init_SSD1963_480, _setxy_ssd1963, _init_done_ssd1963_480);
@@ -1,78 +1,29 @@
-case SSD1963_800:
-	LCD_Write_COM(0xE2);		//PLL multiplier, set PLL clock to 120M
-	LCD_Write_DATA(0x1E);	    //N=0x36 for 6.5M, 0x23 for 10M crystal
-	LCD_Write_DATA(0x02);
-	LCD_Write_DATA(0x54);
-	LCD_Write_COM(0xE0);		// PLL enable
-	LCD_Write_DATA(0x01);
-	delay(10);
-	LCD_Write_COM(0xE0);
-	LCD_Write_DATA(0x03);
-	delay(10);
-	LCD_Write_COM(0x01);		// software reset
-	delay(100);
-	LCD_Write_COM(0xE6);		//PLL setting for PCLK, depends on resolution
-	LCD_Write_DATA(0x03);
-	LCD_Write_DATA(0xFF);
-	LCD_Write_DATA(0xFF);
-
-	LCD_Write_COM(0xB0);		//LCD SPECIFICATION
-	LCD_Write_DATA(0x24);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x03);		//Set HDP	799
-	LCD_Write_DATA(0x1F);
-	LCD_Write_DATA(0x01);		//Set VDP	479
-	LCD_Write_DATA(0xDF);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xB4);		//HSYNC
-	LCD_Write_DATA(0x03);		//Set HT	928
-	LCD_Write_DATA(0xA0);
-	LCD_Write_DATA(0x00);		//Set HPS	46
-	LCD_Write_DATA(0x2E);
-	LCD_Write_DATA(0x30);		//Set HPW	48
-	LCD_Write_DATA(0x00);		//Set LPS	15
-	LCD_Write_DATA(0x0F);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xB6);		//VSYNC
-	LCD_Write_DATA(0x02);		//Set VT	525
-	LCD_Write_DATA(0x0D);
-	LCD_Write_DATA(0x00);		//Set VPS	16
-	LCD_Write_DATA(0x10);
-	LCD_Write_DATA(0x10);		//Set VPW	16
-	LCD_Write_DATA(0x00);		//Set FPS	8
-	LCD_Write_DATA(0x08);
-
-	LCD_Write_COM(0xBA);
-	LCD_Write_DATA(0x0F);		//GPIO[3:0] out 1
-
-	LCD_Write_COM(0xB8);
-	LCD_Write_DATA(0x07);	    //GPIO3=input, GPIO[2:0]=output
-	LCD_Write_DATA(0x01);		//GPIO0 normal
-
-	LCD_Write_COM(0x36);		//rotation
-	LCD_Write_DATA(0x22);
-
-	LCD_Write_COM(0xF0);		//pixel data interface
-	LCD_Write_DATA(0x03);
-
-
-	delay(1);
-
-	setXY(0, 0, 799, 479);
-	LCD_Write_COM(0x29);		//display on
-
-	LCD_Write_COM(0xBE);		//set PWM for B/L
-	LCD_Write_DATA(0x06);
-	LCD_Write_DATA(0xf0);
-	LCD_Write_DATA(0x01);
-	LCD_Write_DATA(0xf0);
-	LCD_Write_DATA(0x00);
-	LCD_Write_DATA(0x00);
-
-	LCD_Write_COM(0xd0); 
-	LCD_Write_DATA(0x0d);	
-
-	LCD_Write_COM(0x2C); 
-	break;
+// SSD1963, 800x480
+static const uint8_t _init_SSD1963_800[]={
+	3,	0xE2, 0x1E, 0x02, 0x54,		// PLL multiplier, set PLL clock to 120M
+	1,	0xE0, 0x01,		// PLL enable
+	UTFT_INIT_DELAY, 10,
+	1,	0xE0, 0x03,
+	UTFT_INIT_DELAY, 10,
+	0,	0x01,		// software reset
+	UTFT_INIT_DELAY, 100,
+	3,	0xE6, 0x03, 0xFF, 0xFF,		// PLL setting for PCLK, depends on resolution
+	7,	0xB0, 0x24, 0x00, 0x03, 0x1F, 0x01, 0xDF, 0x00,		// LCD SPECIFICATION
+	8,	0xB4, 0x03, 0xA0, 0x00, 0x2E, 0x30, 0x00, 0x0F, 0x00,		// HSYNC
+	7,	0xB6, 0x02, 0x0D, 0x00, 0x10, 0x10, 0x00, 0x08,		// VSYNC
+	1,	0xBA, 0x0F,		// GPIO[3:0] out 1
+	2,	0xB8, 0x07, 0x01,		// GPIO3=input, GPIO[2:0]=output
+	1,	0x36, 0x22,		// rotation
+	1,	0xF0, 0x03,		// pixel data interface
+	UTFT_INIT_DELAY, 1,
+	UTFT_INIT_END
+};
+
+// SSD1963, 800x480, after the window is set
+static const uint8_t _init_SSD1963_800_ON[]={
+	0,	0x29,		// display on
+	6,	0xBE, 0x06, 0xF0, 0x01, 0xF0, 0x00, 0x00,		// set PWM for B/L
+	1,	0xD0, 0x0D,
+	0,	0x2C,
+	UTFT_INIT_END
+};
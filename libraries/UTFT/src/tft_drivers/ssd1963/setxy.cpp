@@ -0,0 +1,24 @@
+/*
+  SSD1963 address window
+*/
+
+#include "UTFT.h"
+#include "hardware/arm/HW_STM32F_bus.h"
+
+// SSD1963, all panel sizes: the window is given in panel coordinates
+void _setxy_ssd1963(UTFT *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	swap(word, x1, y1);
+	swap(word, x2, y2);
+	lcd->LCD_Write_COM(0x2a);
+	lcd->LCD_Write_DATA(x1>>8);
+	lcd->LCD_Write_DATA(x1);
+	lcd->LCD_Write_DATA(x2>>8);
+	lcd->LCD_Write_DATA(x2);
+	lcd->LCD_Write_COM(0x2b);
+	lcd->LCD_Write_DATA(y1>>8);
+	lcd->LCD_Write_DATA(y1);
+	lcd->LCD_Write_DATA(y2>>8);
+	lcd->LCD_Write_DATA(y2);
+	lcd->LCD_Write_COM(0x2c);
+}
@@ -0,0 +1,9 @@
+/*
+  ST7735 driver (alternative init)
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ST7735_ALT, 0, 127, 159, SERIAL_5PIN, _init_ST7735_ALT, _setxy_dcs, 0);
@@ -0,0 +1,9 @@
+/*
+  ST7735 driver
+*/
+
+#include "UTFT.h"
+#include "tft_drivers/common/setxy.h"
+#include "initlcd.h"
+
+UTFT_DRIVER(ST7735, 0, 127, 159, SERIAL_5PIN, _init_ST7735, _setxy_dcs, 0);